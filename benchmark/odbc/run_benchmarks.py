@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Run the ODBC benchmarks and report rows/s and MB/s per benchmark.
+
+Wraps DuckDB's benchmark_runner: timings come from the runner, row counts and
+payload sizes from the TABLE and ROWS parameters of each benchmark file.
+"""
+
+import argparse
+import re
+import statistics
+import subprocess
+import sys
+
+# Payload bytes per generated row (see the *_source views in templates/)
+ROW_BYTES = {
+    'narrow': 8 + 4 + 8,
+    'wide': 8 + 8 * 4 + 8 * 8 + 4 * 16,
+    'strings': 8 + 4 * 32,
+    'nulls': 8 + 0.1 * (4 + 8 + 16),
+}
+
+
+def read_parameters(path):
+    parameters = {}
+    with open(path) as f:
+        for line in f:
+            match = re.match(r'^([A-Z_]+)=(.*)$', line.strip())
+            if match:
+                parameters[match.group(1)] = match.group(2)
+    return parameters
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--runner', default='build/release/benchmark/benchmark_runner')
+    parser.add_argument('--pattern', default='benchmark/odbc/(duckdb|sqlite)/.*')
+    parser.add_argument('--nruns', type=int, default=3)
+    args = parser.parse_args()
+
+    command = [args.runner, args.pattern, '--nruns=%d' % args.nruns]
+    print(' '.join(command), file=sys.stderr)
+    process = subprocess.run(command, stdout=subprocess.PIPE, universal_newlines=True)
+    if process.returncode != 0:
+        sys.stdout.write(process.stdout)
+        return process.returncode
+
+    # Runner output: <benchmark file>\t<run>\t<seconds>
+    timings = {}
+    for line in process.stdout.splitlines():
+        fields = line.split('\t')
+        if len(fields) != 3:
+            continue
+        try:
+            timings.setdefault(fields[0], []).append(float(fields[2]))
+        except ValueError:
+            continue
+
+    print('%-50s %10s %14s %10s' % ('benchmark', 'seconds', 'rows/s', 'MB/s'))
+    for name in sorted(timings):
+        seconds = statistics.median(timings[name])
+        parameters = read_parameters(name)
+        rows = int(parameters.get('ROWS', 0))
+        row_bytes = ROW_BYTES.get(parameters.get('TABLE'), 0)
+        rows_per_second = rows / seconds if seconds > 0 else 0
+        mb_per_second = rows * row_bytes / seconds / 1e6 if seconds > 0 else 0
+        print('%-50s %10.3f %14.0f %10.1f' % (name, seconds, rows_per_second, mb_per_second))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "odbc_headers.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Why a driver call was cancelled
+ */
+enum class OdbcCancelReason { NONE, INTERRUPTED, TIMEOUT };
+
+/**
+ * @brief Cancels blocking driver calls of one database instance
+ * A background thread watches the registered calls and sends SQLCancel for the
+ * statement of a call whose query was interrupted or whose deadline has passed.
+ * The thread only polls while calls are registered.
+ */
+class OdbcCancelWatchdog : public ObjectCacheEntry {
+public:
+    // How often running calls are checked
+    static constexpr idx_t POLL_INTERVAL_MS = 100;
+
+    // Get the watchdog of the context's database
+    static std::shared_ptr<OdbcCancelWatchdog> Get(ClientContext &context);
+
+    // Stop the thread (no calls are registered any more)
+    ~OdbcCancelWatchdog() override;
+
+    // Watch a call on handle; timeout_seconds = 0 only cancels on interruption. Returns the call's id.
+    idx_t Register(ClientContext &context, SQLHSTMT handle, idx_t timeout_seconds);
+
+    // Stop watching a call, returns whether and why it was cancelled
+    OdbcCancelReason Unregister(idx_t id);
+
+    static std::string ObjectType() { return "odbc_cancel_watchdog"; }
+    std::string GetObjectType() override { return ObjectType(); }
+
+private:
+    struct WatchedCall {
+        ClientContext *context;
+        SQLHSTMT handle;
+        bool has_deadline;
+        std::chrono::steady_clock::time_point deadline;
+        OdbcCancelReason reason;
+    };
+
+    void Run();
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::unordered_map<idx_t, WatchedCall> calls;
+    idx_t next_id = 0;
+    bool stopped = false;
+    std::thread thread;
+};
+
+/**
+ * @brief Watches one driver call for the duration of a scope
+ * Use ThrowIfCancelled in the error path of the call, a cancelled call fails with
+ * a driver error that does not say why it was cancelled.
+ */
+class OdbcCancelGuard {
+public:
+    // Throws an InterruptException right away if the query was already interrupted.
+    // timeout_option names the setting in the timeout error.
+    OdbcCancelGuard(ClientContext &context, SQLHSTMT handle, idx_t timeout_seconds, const char *timeout_option);
+    ~OdbcCancelGuard();
+
+    // Forbid copying
+    OdbcCancelGuard(const OdbcCancelGuard &) = delete;
+    OdbcCancelGuard &operator=(const OdbcCancelGuard &) = delete;
+
+    // Throw the interruption or timeout error if the call was cancelled, return otherwise
+    void ThrowIfCancelled();
+
+private:
+    void Finish();
+
+    std::shared_ptr<OdbcCancelWatchdog> watchdog;
+    idx_t id;
+    idx_t timeout_seconds;
+    const char *timeout_option;
+    bool finished = false;
+    OdbcCancelReason reason = OdbcCancelReason::NONE;
+};
+
+} // namespace duckdb
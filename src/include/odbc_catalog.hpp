@@ -0,0 +1,183 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/storage/storage_extension.hpp"
+#include "duckdb/transaction/transaction.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
+#include "odbc_connection.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_parameters.hpp"
+#include <unordered_map>
+
+namespace duckdb {
+
+class OdbcCatalog;
+
+/**
+ * @brief Remote table or view of an attached ODBC database
+ * Scans go through odbc_scan, so filter, projection and limit pushdown apply
+ */
+class OdbcTableEntry : public TableCatalogEntry {
+public:
+    OdbcTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info, std::string remote_schema);
+
+    unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override;
+    TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
+    TableStorageInfo GetStorageInfo(ClientContext &context) override;
+
+private:
+    // Schema the driver reported for the table (empty if it has none)
+    std::string remote_schema;
+
+    // Row count estimate, read on the first scan rather than when tables are listed
+    std::mutex cardinality_lock;
+    bool cardinality_loaded = false;
+    optional_idx cardinality;
+};
+
+/**
+ * @brief Schema of an attached ODBC database
+ * Tables are looked up with SQLColumns the first time they are referenced and
+ * kept for the lifetime of the attachment. The "main" schema resolves names in
+ * the connection's default schema; if the data source does not say which one that
+ * is, in all schemas, as long as the name is unique among them.
+ */
+class OdbcSchemaEntry : public SchemaCatalogEntry {
+public:
+    OdbcSchemaEntry(Catalog &catalog, CreateSchemaInfo &info, std::string remote_schema);
+
+    optional_ptr<CatalogEntry> GetEntry(CatalogTransaction transaction, CatalogType type, const string &name) override;
+    void Scan(ClientContext &context, CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+    void Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+
+    // The attached database is read-only - changes go through odbc_exec
+    optional_ptr<CatalogEntry> CreateTable(CatalogTransaction transaction, BoundCreateTableInfo &info) override;
+    optional_ptr<CatalogEntry> CreateFunction(CatalogTransaction transaction, CreateFunctionInfo &info) override;
+    optional_ptr<CatalogEntry> CreateIndex(CatalogTransaction transaction, CreateIndexInfo &info,
+                                           TableCatalogEntry &table) override;
+    optional_ptr<CatalogEntry> CreateView(CatalogTransaction transaction, CreateViewInfo &info) override;
+    optional_ptr<CatalogEntry> CreateSequence(CatalogTransaction transaction, CreateSequenceInfo &info) override;
+    optional_ptr<CatalogEntry> CreateTableFunction(CatalogTransaction transaction,
+                                                   CreateTableFunctionInfo &info) override;
+    optional_ptr<CatalogEntry> CreateCopyFunction(CatalogTransaction transaction,
+                                                  CreateCopyFunctionInfo &info) override;
+    optional_ptr<CatalogEntry> CreatePragmaFunction(CatalogTransaction transaction,
+                                                    CreatePragmaFunctionInfo &info) override;
+    optional_ptr<CatalogEntry> CreateCollation(CatalogTransaction transaction, CreateCollationInfo &info) override;
+    optional_ptr<CatalogEntry> CreateType(CatalogTransaction transaction, CreateTypeInfo &info) override;
+    void DropEntry(ClientContext &context, DropInfo &info) override;
+    void Alter(CatalogTransaction transaction, AlterInfo &info) override;
+
+private:
+    // Create the entry of a remote table (caller holds the lock)
+    OdbcTableEntry &AddTable(const OdbcTableInfo &table);
+
+    // Schema filter passed to SQLColumns (empty = all schemas, for "main" of a data source
+    // whose default schema is unknown)
+    std::string remote_schema;
+
+    std::mutex lock;
+    // Keyed by lower-case name, DuckDB resolves identifiers case-insensitively
+    std::unordered_map<std::string, unique_ptr<OdbcTableEntry>> tables;
+    // True once every table of the schema has been loaded (by a Scan)
+    bool fully_loaded = false;
+};
+
+/**
+ * @brief Catalog of a database attached with ATTACH ... (TYPE odbc)
+ * Nothing is read from the data source at attach time beyond the DBMS name and
+ * the default schema; schemas and tables are resolved on first reference.
+ */
+class OdbcCatalog : public Catalog {
+public:
+    OdbcCatalog(AttachedDatabase &db, ConnectionParams connection_params, OdbcOptions options,
+                std::shared_ptr<OdbcConnectionPool> pool, std::string dbms_name, std::string default_schema);
+
+    void Initialize(bool load_builtin) override;
+    string GetCatalogType() override { return "odbc"; }
+
+    optional_ptr<SchemaCatalogEntry> GetSchema(CatalogTransaction transaction, const string &schema_name,
+                                               OnEntryNotFound if_not_found,
+                                               QueryErrorContext error_context = QueryErrorContext()) override;
+    void ScanSchemas(ClientContext &context, std::function<void(SchemaCatalogEntry &)> callback) override;
+
+    optional_ptr<CatalogEntry> CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) override;
+    void DropSchema(ClientContext &context, DropInfo &info) override;
+    unique_ptr<PhysicalOperator> PlanCreateTableAs(ClientContext &context, LogicalCreateTable &op,
+                                                   unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanInsert(ClientContext &context, LogicalInsert &op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanDelete(ClientContext &context, LogicalDelete &op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<PhysicalOperator> PlanUpdate(ClientContext &context, LogicalUpdate &op,
+                                            unique_ptr<PhysicalOperator> plan) override;
+    unique_ptr<LogicalOperator> BindCreateIndex(Binder &binder, CreateStatement &stmt, TableCatalogEntry &table,
+                                                unique_ptr<LogicalOperator> plan) override;
+
+    DatabaseSize GetDatabaseSize(ClientContext &context) override;
+    bool InMemory() override { return false; }
+    string GetDBPath() override;
+
+    // Connection to the data source from the attachment's pool
+    std::shared_ptr<OdbcConnection> GetConnection();
+
+    const ConnectionParams &GetConnectionParams() const { return connection_params; }
+    const OdbcOptions &GetOptions() const { return options; }
+    const std::string &GetDbmsName() const { return dbms_name; }
+
+private:
+    // Get or create the entry of a schema (name as used in DuckDB)
+    OdbcSchemaEntry &GetOrCreateSchema(const std::string &schema_name);
+    // Create entries for all remote schemas (one catalog call per attachment)
+    void LoadSchemas();
+
+    ConnectionParams connection_params;
+    OdbcOptions options;
+    std::shared_ptr<OdbcConnectionPool> pool;
+    std::string dbms_name;
+    // Remote schema behind "main" (empty if the data source has none or did not report it)
+    std::string default_schema;
+
+    std::mutex lock;
+    std::unordered_map<std::string, unique_ptr<OdbcSchemaEntry>> schemas;
+    bool schemas_loaded = false;
+};
+
+/**
+ * @brief Transaction of an attached ODBC database
+ * Statements run in autocommit mode on the data source, so there is nothing to track
+ */
+class OdbcTransaction : public Transaction {
+public:
+    OdbcTransaction(TransactionManager &manager, ClientContext &context) : Transaction(manager, context) {}
+};
+
+/**
+ * @brief Transaction manager of an attached ODBC database
+ */
+class OdbcTransactionManager : public TransactionManager {
+public:
+    explicit OdbcTransactionManager(AttachedDatabase &db) : TransactionManager(db) {}
+
+    Transaction &StartTransaction(ClientContext &context) override;
+    ErrorData CommitTransaction(ClientContext &context, Transaction &transaction) override;
+    void RollbackTransaction(Transaction &transaction) override;
+    void Checkpoint(ClientContext &context, bool force = false) override {}
+
+private:
+    std::mutex transaction_lock;
+    reference_map_t<Transaction, unique_ptr<OdbcTransaction>> transactions;
+};
+
+/**
+ * @brief Storage extension behind ATTACH '<dsn or connection string>' AS name (TYPE odbc)
+ */
+class OdbcStorageExtension : public StorageExtension {
+public:
+    OdbcStorageExtension();
+};
+
+} // namespace duckdb
@@ -2,12 +2,14 @@
 
 #include "duckdb.hpp"
 #include "odbc_headers.hpp"
+#include <list>
 #include <memory>
 
 namespace duckdb {
 
 // Forward declarations
 class OdbcStatement;
+struct OdbcDriverInfo;
 
 /**
  * @brief Unified connection parameters
@@ -16,14 +18,15 @@ class OdbcStatement;
 class ConnectionParams {
 public:
     // Default constructor
-    ConnectionParams() : timeout(60), read_only(true), is_dsn(false) {}
+    ConnectionParams() : timeout(60), read_only(true), isolation(0), is_dsn(false) {}
     
     // Create with either DSN or connection string
     ConnectionParams(std::string connection_info, 
                    std::string username = "",
                    std::string password = "",
                    int timeout = 60,
-                   bool read_only = true);
+                   bool read_only = true,
+                   SQLUINTEGER isolation = 0);
     
     // Check if we have valid connection information
     bool IsValid() const;
@@ -31,12 +34,20 @@ public:
     // Get the connection string to use
     std::string GetConnectionString() const;
     
+    // Identity of the data source and session settings (used as connection pool key)
+    std::string GetKey() const;
+    
+    // Identity of the data source alone (driver capabilities are kept per data source)
+    std::string GetDataSourceKey() const;
+    
     // Getters
     const std::string& GetDsn() const { return dsn; }
     const std::string& GetUsername() const { return username; }
     const std::string& GetPassword() const { return password; }
     int GetTimeout() const { return timeout; }
     bool IsReadOnly() const { return read_only; }
+    // SQL_TXN_* isolation level set on every connection (0 = driver default)
+    SQLUINTEGER GetIsolation() const { return isolation; }
     
 private:
     std::string dsn;
@@ -45,9 +56,28 @@ private:
     std::string password;
     int timeout;
     bool read_only;
+    SQLUINTEGER isolation;
     bool is_dsn;
 };
 
+/**
+ * @brief Column of a remote table as reported by SQLColumns
+ */
+struct OdbcColumnInfo {
+    std::string name;
+    LogicalType type;
+    bool not_null = false;
+};
+
+/**
+ * @brief Remote table or view with its columns
+ */
+struct OdbcTableInfo {
+    std::string schema;
+    std::string name;
+    std::vector<OdbcColumnInfo> columns;
+};
+
 /**
  * @brief ODBC database connection
  * Manages connection to ODBC data sources
@@ -74,15 +104,44 @@ public:
     // Prepare a statement
     unique_ptr<OdbcStatement> Prepare(const std::string &query);
     
-    // Execute a simple statement (no results)
-    void Execute(const std::string &query);
+    // Prepare a statement, taking an idle prepared statement with the same SQL text from the
+    // connection's statement cache if there is one (no SQLPrepare). Hand it back with
+    // ReleaseStatement once its result is consumed.
+    unique_ptr<OdbcStatement> PrepareCached(const std::string &query);
+    
+    // Return a statement to the statement cache, evicting the least recently used one if full
+    void ReleaseStatement(unique_ptr<OdbcStatement> statement);
+    
+    // Idle prepared statements kept per connection
+    static constexpr idx_t STATEMENT_CACHE_SIZE = 16;
+    
+    // Execute a simple statement (no results), returns the affected row count (-1 if unknown).
+    // query_timeout limits its execution in seconds (0 = no limit).
+    int64_t Execute(const std::string &query, idx_t query_timeout = 0);
+    // Same, on a statement handle watched by the cancel watchdog, so that an interrupted
+    // query or the query_timeout cancels the call in the driver
+    int64_t Execute(ClientContext &context, const std::string &query, idx_t query_timeout = 0);
     
     // Check if the connection is open
     bool IsOpen() const;
     
-    // Get tables from the connection
-    std::vector<std::string> GetTables();
-    std::vector<std::string> GetViews();
+    // Check that the connection is open and the driver does not report it as dead
+    bool IsHealthy();
+    
+    // Get the names of all tables and of all views (VIEW and SYSTEM VIEW) with one SQLTables call
+    void GetTablesAndViews(std::vector<std::string> &tables, std::vector<std::string> &views);
+    
+    // Get the primary key column of a table (empty unless the key has exactly one column)
+    std::string GetPrimaryKeyColumn(const std::string &tableName);
+    
+    // Get the columns of all tables matching table_pattern in schema (empty = any) with one
+    // SQLColumns call, grouped by table in the order the driver returns them
+    std::vector<OdbcTableInfo> GetColumns(const std::string &schemaName, const std::string &tablePattern,
+                                          bool allVarchar = false);
+    
+    // Row count of a table as reported by SQLStatistics (SQL_TABLE_STAT row, SQL_QUICK accuracy).
+    // Invalid if the driver does not report one.
+    optional_idx GetTableCardinality(const std::string &schemaName, const std::string &tableName);
     
     // Get columns for a table
     void GetTableInfo(const std::string &tableName, ColumnList &columns, 
@@ -92,8 +151,18 @@ public:
     nanodbc::connection& GetNativeConnection() { return connection; }
     const nanodbc::connection& GetNativeConnection() const { return connection; }
     
+    // Capabilities of the driver (set by the connection pool; the most conservative ones until then)
+    const OdbcDriverInfo &GetDriverInfo() const;
+    void SetDriverInfo(std::shared_ptr<const OdbcDriverInfo> info);
+    
 private:
+    // Free the cached statements (before the connection is closed)
+    void ClearStatementCache();
+    
     nanodbc::connection connection;
+    std::shared_ptr<const OdbcDriverInfo> driver_info;
+    // Idle prepared statements, most recently released first
+    std::list<unique_ptr<OdbcStatement>> statement_cache;
 };
 
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "odbc_connection.hpp"
+#include "odbc_driver_info.hpp"
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Pool of idle ODBC connections for one database instance
+ * Connections are keyed by their connection parameters and handed out as shared
+ * pointers that return the connection to the pool when the last owner releases it.
+ * The pool also remembers the driver capabilities of each data source, probed on
+ * its first connection, and hands them to every connection it gives out.
+ */
+class OdbcConnectionPool : public ObjectCacheEntry, public std::enable_shared_from_this<OdbcConnectionPool> {
+public:
+    // Default limits, overridable with the odbc_pool_size / odbc_pool_idle_timeout settings
+    static constexpr idx_t DEFAULT_POOL_SIZE = 8;
+    static constexpr idx_t DEFAULT_IDLE_TIMEOUT_SECONDS = 300;
+
+    // Get a connection for params, reusing an idle one of the database's pool if possible
+    static std::shared_ptr<OdbcConnection> Acquire(ClientContext &context, const ConnectionParams &params);
+
+    // Get the pool of the context's database, with the current limits applied
+    static std::shared_ptr<OdbcConnectionPool> Get(ClientContext &context);
+
+    // Register the pool settings
+    static void RegisterSettings(DBConfig &config);
+
+    // Take a healthy idle connection or open a new one
+    std::shared_ptr<OdbcConnection> AcquireConnection(const ConnectionParams &params);
+
+    // Update the idle size (per connection key) and timeout
+    void SetLimits(idx_t max_idle, idx_t idle_timeout_seconds);
+
+    // Close all idle connections
+    void Clear();
+
+    // Capabilities of the data source's driver as probed (null before its first connection)
+    std::shared_ptr<const OdbcDriverInfo> GetDetectedDriverInfo(const ConnectionParams &params);
+
+    // Capabilities connections to the data source use: the probed ones with the overrides applied
+    std::shared_ptr<const OdbcDriverInfo> GetDriverInfo(const ConnectionParams &params);
+
+    // Override capabilities of the data source for the connections handed out from now on.
+    // With reset, earlier overrides are dropped first.
+    void OverrideDriverInfo(const ConnectionParams &params, const vector<std::pair<std::string, Value>> &overrides,
+                            bool reset);
+
+    static std::string ObjectType() { return "odbc_connection_pool"; }
+    std::string GetObjectType() override { return ObjectType(); }
+
+private:
+    struct DriverProfile {
+        std::shared_ptr<const OdbcDriverInfo> detected;
+        std::shared_ptr<const OdbcDriverInfo> effective;
+        vector<std::pair<std::string, Value>> overrides;
+    };
+    
+    struct IdleConnection {
+        unique_ptr<OdbcConnection> connection;
+        std::chrono::steady_clock::time_point released;
+    };
+
+    // Pop the most recently released connection for key (null if none)
+    unique_ptr<OdbcConnection> TakeIdle(const std::string &key);
+    // Return a connection; closes it if it is broken or the pool is full
+    void Release(const std::string &key, unique_ptr<OdbcConnection> connection);
+    // Move idle connections past the timeout into expired (caller holds the lock)
+    void CollectExpired(vector<unique_ptr<OdbcConnection>> &expired);
+    // Probe the driver on the data source's first connection and attach the capabilities
+    void AttachDriverInfo(const ConnectionParams &params, OdbcConnection &connection);
+    // Apply the overrides to the detected capabilities (caller holds the lock)
+    static void UpdateEffective(DriverProfile &profile);
+
+    std::mutex lock;
+    std::unordered_map<std::string, std::deque<IdleConnection>> idle;
+    // Keyed by ConnectionParams::GetDataSourceKey, kept when the idle connections are cleared
+    std::unordered_map<std::string, DriverProfile> drivers;
+    idx_t max_idle = DEFAULT_POOL_SIZE;
+    idx_t idle_timeout_seconds = DEFAULT_IDLE_TIMEOUT_SECONDS;
+};
+
+} // namespace duckdb
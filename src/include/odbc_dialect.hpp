@@ -0,0 +1,54 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief Row limiting syntax of a data source
+ */
+enum class OdbcLimitSyntax {
+    NONE,         // Unknown data source - limits are not pushed
+    LIMIT,        // SELECT ... LIMIT n (PostgreSQL, MySQL, SQLite, DuckDB, Snowflake, ...)
+    TOP,          // SELECT TOP n ... (SQL Server, Access, Sybase)
+    FETCH_FIRST,  // SELECT ... FETCH FIRST n ROWS ONLY (DB2, Derby)
+    ROWNUM        // SELECT * FROM (SELECT ...) WHERE ROWNUM <= n (Oracle)
+};
+
+/**
+ * @brief SQL dialect differences between data sources
+ * The dialect is chosen from the DBMS name the driver reports (SQLGetInfo(SQL_DBMS_NAME))
+ */
+class OdbcDialect {
+public:
+    // Row limiting syntax for a DBMS name
+    static OdbcLimitSyntax GetLimitSyntax(const std::string &dbms_name);
+
+    // Build "SELECT <select_list> <table_expression> [ORDER BY <order_by>]" limited to limit rows
+    static std::string LimitQuery(OdbcLimitSyntax syntax, const std::string &select_list,
+                                  const std::string &table_expression, const std::string &order_by, idx_t limit);
+
+    // Name of the COUNT function returning a 64-bit count (SQL Server and Sybase: COUNT_BIG,
+    // their COUNT fails beyond 2^31 rows)
+    static std::string CountFunction(const std::string &dbms_name);
+
+    // Catalog query returning the optimizer's row count estimate of a table as a single
+    // numeric value, or an empty string if the DBMS has no known statistics view
+    static std::string RowCountQuery(const std::string &dbms_name, const std::string &schema_name,
+                                     const std::string &table_name);
+
+    // Query returning the schema unqualified table names resolve to, or an empty string if the
+    // DBMS has no schemas (SQLite) or none is known (MySQL/MariaDB map databases to catalogs)
+    static std::string CurrentSchemaQuery(const std::string &dbms_name);
+
+    // Query returning an identifier of the current transaction's snapshot that other sessions can
+    // import, or an empty string if the DBMS cannot share snapshots (PostgreSQL only)
+    static std::string ExportSnapshotQuery(const std::string &dbms_name);
+
+    // Statements that make the transaction just started on another session read from the
+    // exported snapshot; they must run before its first query
+    static std::vector<std::string> ImportSnapshotStatements(const std::string &dbms_name,
+                                                             const std::string &snapshot_id);
+};
+
+} // namespace duckdb
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "odbc_headers.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief What an ODBC driver supports, as far as the fetch and bind strategy depends on it
+ * Probed with SQLGetInfo / SQLGetFunctions and a scratch statement on the first connection
+ * to a data source and kept by the connection pool (see odbc_driver_info()). A driver that
+ * does not answer a probe is assumed to lack the capability.
+ */
+struct OdbcDriverInfo {
+    // Reported by SQLGetInfo, informational only
+    std::string dbms_name;
+    std::string dbms_version;
+    std::string driver_name;
+    std::string driver_version;
+    std::string driver_odbc_version;
+    // SQL_ASYNC_MODE: none, connection or statement (calls are cancelled from another thread instead)
+    std::string async_mode = "none";
+
+    // SQLFetchScroll with a rowset of more than one row
+    bool block_cursors = false;
+    // Largest SQL_ATTR_ROW_ARRAY_SIZE the driver accepts
+    idx_t max_rowset_size = 1;
+    // SQLGetData for columns before the last bound one (SQL_GD_ANY_COLUMN)
+    bool getdata_any_column = false;
+    // SQLGetData in any column order (SQL_GD_ANY_ORDER)
+    bool getdata_any_order = false;
+    // SQLGetData on rows of a block cursor positioned with SQLSetPos (SQL_GD_BLOCK)
+    bool getdata_block = false;
+    // SQLGetData for bound columns (SQL_GD_BOUND)
+    bool getdata_bound = false;
+    // Arrays of parameter values (SQL_ATTR_PARAMSET_SIZE above 1)
+    bool param_arrays = false;
+
+    // Probe the driver of an open connection
+    static OdbcDriverInfo Probe(SQLHDBC dbc);
+
+    // Names of the capabilities that can be overridden
+    static const vector<std::string> &OverridableNames();
+
+    // Override a capability by name; throws for unknown names and values of the wrong type
+    void Set(const std::string &name, const Value &value);
+
+    // Name and value of every field, in display order
+    vector<std::pair<std::string, Value>> GetValues() const;
+
+    // Rowset size to use for a requested size
+    idx_t LimitRowsetSize(idx_t size) const {
+        return block_cursors ? MaxValue<idx_t>(MinValue<idx_t>(size, max_rowset_size), 1) : 1;
+    }
+};
+
+// odbc_driver_info(connection=...): detected and effective driver capabilities of a data source
+TableFunction OdbcDriverInfoFunction();
+
+} // namespace duckdb
@@ -5,6 +5,10 @@
 #include <vector>
 #include <unordered_map>
 
+#ifndef _WIN32
+#include <iconv.h>
+#endif
+
 namespace duckdb {
 
 class OdbcEncoding {
@@ -15,25 +19,79 @@ public:
     // Check if conversion is needed
     static bool NeedsConversion(const std::string& encoding);
     
+    // Throw a BinderException if values cannot be converted from encoding on this platform
+    static void VerifyEncoding(const std::string& encoding);
+    
     // Normalize encoding name (e.g., "utf8" -> "UTF-8")
     static std::string NormalizeEncodingName(const std::string& encoding);
     
     // Get codepage for Windows encoding name
     static int GetWindowsCodepage(const std::string& encoding);
+    
+    // Check whether a buffer only holds 7-bit ASCII, which needs no conversion
+    static bool IsAscii(const char* data, idx_t length);
+    
+    // Throw if character data read without conversion (encoding 'UTF-8') is not valid UTF-8,
+    // i.e. the data source sends another character set
+    static void VerifyUtf8(const char* data, idx_t length);
+    
+    // Convert count UTF-16 (or UTF-32, where SQLWCHAR is wchar_t) code units to UTF-8 and
+    // store the result in the string heap of out, keeping whole characters of at most
+    // max_bytes bytes (0 = no limit). Unpaired surrogates become U+FFFD. Sets truncated
+    // if the UTF-8 form is longer than max_bytes.
+    static string_t WideToVector(Vector& out, const uint16_t* data, idx_t count, idx_t max_bytes, bool& truncated);
+    static string_t WideToVector(Vector& out, const uint32_t* data, idx_t count, idx_t max_bytes, bool& truncated);
+    
+    // Convert count UTF-16 (or UTF-32) code units to a UTF-8 string, e.g. names reported by W functions
+    static std::string WideToString(const uint16_t* data, idx_t count);
+    static std::string WideToString(const uint32_t* data, idx_t count);
+    
+    // Convert a UTF-8 string to null-terminated UTF-16 (or UTF-32) code units, e.g. names passed to W functions
+    static void StringToWide(const std::string& input, std::vector<uint16_t>& out);
+    static void StringToWide(const std::string& input, std::vector<uint32_t>& out);
 
 private:
     // Initialize the encoding map
     static const std::unordered_map<std::string, int> InitializeEncodingMap();
     
-    // Platform-specific conversion functions
+    // Encoding name to Windows codepage map
+    static const std::unordered_map<std::string, int> encoding_to_codepage;
+};
+
+/**
+ * @brief Reusable converter from one source encoding to UTF-8
+ * Resolves the iconv descriptor (or Windows codepage) once and keeps its scratch
+ * buffers, so a scan only pays for the conversion of non-ASCII values. Not thread-safe;
+ * every scan thread owns its own converter.
+ */
+class OdbcEncodingConverter {
+public:
+    explicit OdbcEncodingConverter(const std::string& encoding);
+    ~OdbcEncodingConverter();
+    
+    // Forbid copying
+    OdbcEncodingConverter(const OdbcEncodingConverter&) = delete;
+    OdbcEncodingConverter& operator=(const OdbcEncodingConverter&) = delete;
+    
+    // Convert a value and store it in the string heap of out. ASCII values are stored
+    // unchanged; a value that is not valid in the source encoding throws an InvalidInputException.
+    string_t ConvertToVector(Vector& out, const char* data, idx_t length);
+    
+    // Convert a value to a UTF-8 std::string
+    std::string Convert(const std::string& input);
+    
+private:
+    // Convert into buffer, throwing if the value is not valid in the source encoding
+    void ConvertToBuffer(const char* data, idx_t length);
+    
+    std::string encoding;
 #ifdef _WIN32
-    static std::string ConvertToUTF8_Windows(const std::string& input, int codepage);
+    int codepage = 0;
+    std::vector<wchar_t> wide_buffer;
 #else
-    static std::string ConvertToUTF8_Unix(const std::string& input, const std::string& encoding);
+    iconv_t descriptor = (iconv_t)-1;
 #endif
-    
-    // Encoding name to Windows codepage map
-    static const std::unordered_map<std::string, int> encoding_to_codepage;
+    std::vector<char> buffer;
 };
 
-} // namespace duckdb
\ No newline at end of file
+} // namespace duckdb
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/planner/table_filter.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief Translates DuckDB table filters into a WHERE clause for the data source
+ * Comparisons, IS [NOT] NULL, IN lists and conjunctions are rendered as portable
+ * ODBC SQL. Filters that cannot be sent, or whose remote semantics may differ
+ * (e.g. string collations), are returned as an expression to evaluate locally.
+ */
+class OdbcFilterPushdown {
+public:
+    // Build the remote predicate for the filters of a scan; empty if nothing could be pushed.
+    // Filters that still have to be checked locally are returned in residual, bound to the
+    // output column positions. With enabled = false every filter ends up in residual.
+    static std::string TransformFilters(const vector<column_t> &column_ids, const vector<LogicalType> &types,
+                                        const vector<std::string> &names, optional_ptr<TableFilterSet> filters,
+                                        bool enabled, unique_ptr<Expression> &residual);
+
+    // Render a constant as an ODBC SQL literal, using escape clauses ({d}, {t}, {ts})
+    // for temporal values. Returns false if the value has no portable literal.
+    static bool TryGetLiteral(const Value &value, std::string &literal);
+};
+
+} // namespace duckdb
@@ -19,4 +19,19 @@
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
-#include <sqlucode.h>
\ No newline at end of file
+#include <sqlucode.h>
+
+// SQL Server types (msodbcsql.h) for TIME(n) and DATETIMEOFFSET, which other drivers
+// neither report nor accept
+#ifndef SQL_SS_TIME2
+#define SQL_SS_TIME2 (-154)
+#endif
+#ifndef SQL_SS_TIMESTAMPOFFSET
+#define SQL_SS_TIMESTAMPOFFSET (-155)
+#endif
+#ifndef SQL_C_SS_TIME2
+#define SQL_C_SS_TIME2 0x4000
+#endif
+#ifndef SQL_C_SS_TIMESTAMPOFFSET
+#define SQL_C_SS_TIMESTAMPOFFSET 0x4001
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "odbc_connection.hpp"
+#include "odbc_statement.hpp"
+#include "odbc_parameters.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief C type an odbc_insert column is bound with
+ */
+enum class OdbcInsertKind : uint8_t {
+    SMALLINT,   // short (BOOLEAN, TINYINT, UTINYINT, SMALLINT)
+    INTEGER,    // int (USMALLINT, INTEGER)
+    BIGINT,     // long long (UINTEGER, BIGINT)
+    FLOAT,
+    DOUBLE,
+    DATE,       // nanodbc::date
+    TIME,       // text HH:MM:SS.ffffff (SQL_TIME_STRUCT has no fraction)
+    TIMESTAMP,  // nanodbc::timestamp
+    STRING,     // VARCHAR and every type without a native binding (cast to VARCHAR)
+    BINARY      // BLOB
+};
+
+/**
+ * @brief Column-wise parameter array for one inserted column
+ * Collects up to batch_size values of the pending batch, which are bound with
+ * SQLBindParameter in one call and sent with a single execute
+ */
+struct OdbcInsertColumn {
+    LogicalType type;
+    OdbcInsertKind kind = OdbcInsertKind::STRING;
+    bool cast_to_varchar = false;
+
+    // Parameter description from SQLDescribeParam, or derived from the DuckDB
+    // type when the driver cannot describe parameters
+    SQLSMALLINT sql_type = SQL_VARCHAR;
+    SQLULEN column_size = 0;
+    SQLSMALLINT decimal_digits = 0;
+    bool described = false;
+
+    // Pending values: fixed-width types in values, strings and blobs in their vectors
+    idx_t value_width = 0;
+    unsafe_unique_array<data_t> values;
+    std::vector<std::string> strings;
+    std::vector<std::vector<uint8_t>> blobs;
+    unsafe_unique_array<bool> nulls;
+};
+
+/**
+ * @brief Insert function data
+ */
+struct OdbcInsertFunctionData : public TableFunctionData {
+    ConnectionParams connection_params;
+    std::string table_name;
+    std::string insert_sql;
+    std::vector<std::string> column_names;
+    std::vector<LogicalType> column_types;
+    idx_t batch_size = STANDARD_VECTOR_SIZE;
+    idx_t commit_interval = 0;
+    // Seconds one batch may execute (0 = no limit)
+    idx_t query_timeout = 0;
+};
+
+/**
+ * @brief Per-thread writer of odbc_insert
+ * Each thread inserts through its own connection and transaction
+ */
+struct OdbcInsertLocalState : public LocalTableFunctionState {
+    // Declared before the transaction and statement so that both are gone before
+    // the connection goes back to the pool
+    std::shared_ptr<OdbcConnection> connection;
+    std::unique_ptr<OdbcStatement> statement;
+    std::unique_ptr<nanodbc::transaction> transaction;
+
+    std::vector<OdbcInsertColumn> columns;
+
+    // Rows per execute: batch_size, or 1 if the driver has no parameter arrays
+    idx_t batch_size = 0;
+    // Rows collected for the next execute
+    idx_t pending = 0;
+    idx_t rows_since_commit = 0;
+    idx_t rows_inserted = 0;
+    bool finished = false;
+};
+
+// Function declaration for public API
+TableFunction OdbcInsertFunction();
+
+} // namespace duckdb
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/value_map.hpp"
+#include "odbc_connection.hpp"
+#include "odbc_statement.hpp"
+#include "odbc_parameters.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_rowset.hpp"
+#include <list>
+
+namespace duckdb {
+
+/**
+ * @brief Lookup function data
+ */
+struct OdbcLookupFunctionData : public TableFunctionData {
+    ConnectionParams connection_params;
+    std::string table_name;
+    // Output columns of the remote table, the key column first
+    std::vector<std::string> column_names;
+    std::vector<LogicalType> column_types;
+    OdbcOptions options;
+    // SELECT ... WHERE key IN (?, ...) with options.batch_size markers
+    std::string lookup_sql;
+};
+
+/**
+ * @brief Keys recently sent by any thread of one odbc_lookup call
+ * A key is not looked up again while it is among the last MAX_SENT_KEYS keys sent (at least
+ * one batch), so its rows are returned once however often it repeats within that window.
+ * Older keys are forgotten, which keeps the memory bounded for inputs of any size.
+ */
+struct OdbcLookupGlobalState : public GlobalTableFunctionState {
+    // Record key as sent, returns false if it was sent recently
+    bool ClaimKey(const Value &key, idx_t capacity);
+
+    std::mutex lock;
+    // Least recently seen last
+    std::list<Value> recent_keys;
+    value_map_t<std::list<Value>::iterator> sent_keys;
+};
+
+/**
+ * @brief Per-thread state of odbc_lookup
+ * Collects the keys of the input that no thread has sent yet into batches and streams the rows of
+ * one remote query at a time into the output
+ */
+struct OdbcLookupLocalState : public LocalTableFunctionState {
+    // Hands the prepared lookup back to the connection's statement cache
+    ~OdbcLookupLocalState() override;
+
+    std::shared_ptr<OdbcConnection> connection;
+    // Query of the previous batch whose rows are being returned (null if none)
+    std::unique_ptr<OdbcStatement> statement;
+    std::unique_ptr<OdbcEncodingConverter> encoding_converter;
+    std::vector<OdbcColumnBuffer> long_columns;
+
+    // Keys of the batch being collected, each claimed in OdbcLookupGlobalState
+    std::vector<Value> keys;
+    // Next input row to collect - the input is passed again after HAVE_MORE_OUTPUT
+    idx_t input_offset = 0;
+};
+
+// Function declaration for public API
+TableFunction OdbcLookupFunction();
+
+} // namespace duckdb
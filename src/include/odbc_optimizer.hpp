@@ -0,0 +1,26 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief Optimizer pass for ODBC scans
+ * Pushes constant LIMITs and TOP-N orderings on plain columns into the query
+ * generated by odbc_scan, using the row limiting syntax of the data source.
+ * Aggregates over an odbc_scan whose filters and aggregate functions the data
+ * source evaluates like DuckDB are replaced by an odbc_query of the aggregate.
+ */
+class OdbcOptimizer {
+public:
+    // Register the optimizer extension
+    static void Register(DBConfig &config);
+
+    // Register the odbc_aggregate_pushdown setting
+    static void RegisterSettings(DBConfig &config);
+
+    static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
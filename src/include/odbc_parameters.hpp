@@ -10,6 +10,14 @@ struct OdbcOptions {
     bool all_varchar = false;
     std::string encoding = "UTF-8";  // Default to UTF-8
     bool overwrite = false;
+    idx_t batch_size = STANDARD_VECTOR_SIZE;  // Rows fetched per SQLFetch round trip
+    bool adaptive_batch_size = true;  // batch_size not given: bound rowsets adapt to fetch latency
+    bool filter_pushdown = true;  // Send WHERE filters to the data source (odbc_scan)
+    idx_t max_lob_size = 0;  // Largest character/binary value read in bytes (0 = no limit)
+    bool lob_overflow_null = false;  // Return NULL for larger values instead of truncating them
+    bool cache = false;  // Keep the result in the result cache and serve repeated scans from it
+    idx_t query_timeout = 0;  // Seconds a statement may execute (SQL_ATTR_QUERY_TIMEOUT, 0 = no limit)
+    idx_t fetch_timeout = 0;  // Seconds a single fetch may wait for the driver (0 = no limit)
     // Add other common options as needed
 };
 
@@ -18,6 +26,10 @@ struct OdbcScanParameters {
     ConnectionParams connection;
     std::string table_name;
     OdbcOptions options;
+    std::string partition_column;  // Integer column used to split the scan into ranges
+    idx_t partitions = 0;          // Number of ranges to scan in parallel (0 = not specified)
+    std::string cache_watermark;   // Ascending column a cached result is refreshed by
+    bool snapshot = false;         // Read all ranges of a partitioned scan from one snapshot
 };
 
 // Query-specific parameters
@@ -25,13 +37,40 @@ struct OdbcQueryParameters {
     ConnectionParams connection;
     std::string query;
     OdbcOptions options;
+    std::vector<Value> params;  // Values bound to the ? markers of query, in order
 };
 
 // Exec-specific parameters
 struct OdbcExecParameters {
     ConnectionParams connection;
-    std::string sql;
+    std::vector<std::string> statements;  // Run in order on one connection
     OdbcOptions options;
+    bool transaction = false;  // Run all statements in one transaction
+};
+
+// Insert-specific parameters
+struct OdbcInsertParameters {
+    ConnectionParams connection;
+    std::string table_name;
+    OdbcOptions options;          // options.batch_size is the number of rows sent per execute
+    idx_t commit_interval = 0;    // Rows per transaction (0 = commit once at the end)
+};
+
+// Lookup-specific parameters
+struct OdbcLookupParameters {
+    ConnectionParams connection;
+    std::string table_name;
+    std::string key;                   // Remote key column (empty = name of the input column)
+    std::vector<std::string> columns;  // Remote columns returned with the key (empty = all)
+    OdbcOptions options;               // options.batch_size is the number of keys per remote query
+    
+    // Keys per query unless batch_size is given - stays below common parameter limits
+    // (SQL Server: 2100, SQLite before 3.32: 999)
+    static constexpr idx_t DEFAULT_BATCH_SIZE = 500;
+    // Markers per IN list; larger batches are split into several IN lists joined by OR (Oracle: 1000)
+    static constexpr idx_t MAX_IN_LIST_SIZE = 1000;
+    // Recently sent keys that are not looked up again (see OdbcLookupGlobalState)
+    static constexpr idx_t MAX_SENT_KEYS = 65536;
 };
 
 // Attach-specific parameters
@@ -44,7 +83,7 @@ struct OdbcAttachParameters {
 class OdbcParameterParser {
 public:
     // Parse connection parameters from named parameters
-    static ConnectionParams ParseConnectionParams(const TableFunctionBindInput& input);
+    static ConnectionParams ParseConnectionParams(const TableFunctionBindInput& input, bool default_read_only = true);
     
     // Parse common options from named parameters
     static OdbcOptions ParseCommonOptions(const TableFunctionBindInput& input);
@@ -58,9 +97,21 @@ public:
     // Parse exec-specific parameters
     static OdbcExecParameters ParseExecParameters(const TableFunctionBindInput& input);
     
+    // Parse insert-specific parameters
+    static OdbcInsertParameters ParseInsertParameters(const TableFunctionBindInput& input);
+    
+    // Parse lookup-specific parameters
+    static OdbcLookupParameters ParseLookupParameters(const TableFunctionBindInput& input);
+    
     // Parse attach-specific parameters
     static OdbcAttachParameters ParseAttachParameters(const TableFunctionBindInput& input);
     
+    // Parse a lob_overflow mode ('truncate' or 'null'), returns true for 'null'
+    static bool ParseLobOverflow(const std::string& mode);
+    
+    // Parse an isolation level name, returns the SQL_TXN_* value (0 for the driver default)
+    static SQLUINTEGER ParseIsolationLevel(const std::string& level);
+    
 private:
     // Helper to get a string parameter with error checking
     static std::string GetRequiredString(const TableFunctionBindInput& input, 
@@ -75,6 +126,11 @@ private:
     static bool GetOptionalBoolean(const TableFunctionBindInput& input, 
                                   const std::string& param_name, 
                                   bool default_value = false);
+    
+    // Helper to get an optional integer parameter
+    static int64_t GetOptionalInteger(const TableFunctionBindInput& input, 
+                                     const std::string& param_name, 
+                                     int64_t default_value = 0);
 };
 
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <thread>
+
+namespace duckdb {
+
+/**
+ * @brief Background fetcher for one scan thread
+ * Runs the fetch loop on its own thread and hands converted chunks to the scan
+ * through a bounded queue, so driver round trips overlap with DuckDB execution.
+ * The producer blocks once the queue holds depth chunks (backpressure).
+ */
+class OdbcPrefetcher {
+public:
+    // Fills chunk with the next rows, returns false once the source is exhausted
+    typedef std::function<bool(DataChunk &chunk)> produce_function_t;
+
+    // Default queue depth, overridable with the odbc_prefetch_depth setting (0 disables prefetching)
+    static constexpr idx_t DEFAULT_DEPTH = 2;
+
+    // Register the prefetch setting
+    static void RegisterSettings(DBConfig &config);
+
+    // Queue depth configured for the context
+    static idx_t GetDepth(ClientContext &context);
+
+    // Start producing chunks of the given types
+    OdbcPrefetcher(const vector<LogicalType> &types, idx_t depth, produce_function_t produce);
+
+    // Stop the producer and wait for it to finish its current fetch
+    ~OdbcPrefetcher();
+
+    // Forbid copying
+    OdbcPrefetcher(const OdbcPrefetcher &) = delete;
+    OdbcPrefetcher &operator=(const OdbcPrefetcher &) = delete;
+
+    // Next chunk in source order, or null at the end. Rethrows errors of the producer.
+    unique_ptr<DataChunk> Next();
+
+private:
+    void Run();
+
+    vector<LogicalType> types;
+    idx_t depth;
+    produce_function_t produce;
+
+    std::mutex lock;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<unique_ptr<DataChunk>> queue;
+    bool finished = false;
+    bool stopped = false;
+    std::exception_ptr error;
+
+    std::thread thread;
+};
+
+} // namespace duckdb
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include <list>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Rows of one cached scan result
+ * Never changed once stored; a refresh stores a new result that shares the
+ * segments of the previous one and adds the rows read since.
+ */
+struct OdbcCachedResult {
+    vector<LogicalType> types;
+    std::vector<std::shared_ptr<ColumnDataCollection>> segments;
+    // Largest value of the watermark column the rows were read up to (odbc_scan with
+    // cache_watermark); NULL if there is no watermark or the table had no value yet
+    Value watermark;
+
+    idx_t Count() const;
+    idx_t SizeInBytes() const;
+};
+
+/**
+ * @brief Result cache of odbc_scan / odbc_query for one database instance
+ * Keeps the rows of scans run with cache = true in memory, keyed by data source,
+ * generated SQL and result types, so that a repeated scan is served locally. The
+ * least recently used results are evicted once odbc_result_cache_size is exceeded.
+ */
+class OdbcResultCache : public ObjectCacheEntry {
+public:
+    // Default limit of the cached rows, overridable with the odbc_result_cache_size setting
+    static constexpr idx_t DEFAULT_MAX_SIZE = 256ULL * 1024 * 1024;
+
+    // Get the cache of the context's database, with the current size limit applied
+    static std::shared_ptr<OdbcResultCache> Get(ClientContext &context);
+
+    // Register the cache settings
+    static void RegisterSettings(DBConfig &config);
+
+    // The result stored under key, null on a miss
+    std::shared_ptr<const OdbcCachedResult> Lookup(const std::string &key);
+
+    // Remember a result, evicting others to make room; results larger than the
+    // whole cache are not kept (and drop the previous result of the key)
+    void Store(const std::string &key, std::shared_ptr<const OdbcCachedResult> result);
+
+    // Drop all results, returns how many there were
+    idx_t Clear();
+
+    void SetMaxSize(idx_t max_size);
+
+    static std::string ObjectType() { return "odbc_result_cache"; }
+    std::string GetObjectType() override { return ObjectType(); }
+
+private:
+    struct CachedEntry {
+        std::shared_ptr<const OdbcCachedResult> result;
+        idx_t size = 0;
+        std::list<std::string>::iterator position;
+    };
+
+    // Erase an entry (lock held)
+    void Remove(std::unordered_map<std::string, CachedEntry>::iterator entry);
+
+    std::mutex lock;
+    std::unordered_map<std::string, CachedEntry> entries;
+    // Keys from most to least recently used
+    std::list<std::string> recency;
+    idx_t total_size = 0;
+    idx_t max_size = DEFAULT_MAX_SIZE;
+};
+
+} // namespace duckdb
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "odbc_headers.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_scan_stats.hpp"
+
+namespace duckdb {
+
+class OdbcStatement;
+struct OdbcDriverInfo;
+struct OdbcColumnBuffer;
+
+// SQLWCHAR is UTF-16 with unixODBC and Windows, and wchar_t (UTF-32) with iODBC
+typedef std::conditional<sizeof(SQLWCHAR) == 2, uint16_t, uint32_t>::type odbc_wide_unit_t;
+
+// Copies `count` rows of a bound column, starting at `offset` in the rowset,
+// into `out` starting at `out_offset`
+typedef void (*odbc_column_converter_t)(const OdbcColumnBuffer &buffer, Vector &out,
+                                        idx_t offset, idx_t count, idx_t out_offset);
+
+/**
+ * @brief Bound fetch buffer for a single result column
+ * Holds the SQLBindCol data and indicator arrays for a whole rowset together
+ * with the converter that was resolved for the column's DuckDB type
+ */
+struct OdbcColumnBuffer {
+    SQLSMALLINT c_type = SQL_C_DEFAULT;
+    idx_t value_width = 0;
+    // Width is sized from the described column at bind time (strings, blobs)
+    bool variable_width = false;
+    // False if the column is read with SQLGetData after each fetch (long data)
+    bool bound = true;
+    // Character column the driver describes as SQL_WCHAR / SQL_WVARCHAR: bound as
+    // SQL_C_WCHAR and transcoded from UTF-16 by ConvertWideString. Long values are still
+    // read as c_type.
+    bool wide = false;
+    // TIME column: the C type is picked from the described column so that fractional
+    // seconds survive (SQL_C_TYPE_TIME has none)
+    bool time = false;
+    idx_t allocated_bytes = 0;
+    unsafe_unique_array<data_t> data;
+    unsafe_unique_array<SQLLEN> indicators;
+    // Scratch space for long values of unknown total length, reused across rows
+    std::vector<char> long_buffer;
+    // Text of the current value on the row-by-row path (decimals, UUIDs), reused across rows
+    std::string text;
+    // Largest character or binary value kept in bytes (0 = no limit); larger values
+    // are cut to the limit, or returned as NULL if lob_overflow_null is set
+    idx_t max_lob_size = 0;
+    bool lob_overflow_null = false;
+    // Source encoding of character data (null for UTF-8), owned by the rowset
+    OdbcEncodingConverter *encoding = nullptr;
+    // Target width and scale of DECIMAL columns (fetched as text)
+    uint8_t decimal_width = 0;
+    uint8_t decimal_scale = 0;
+    odbc_column_converter_t convert = nullptr;
+};
+
+/**
+ * @brief Column-wise bound rowset
+ * Binds one typed buffer per column, fetches rowsets with SQLFetchScroll and
+ * converts every column of a rowset into its DuckDB vector in one pass
+ */
+class OdbcRowset {
+public:
+    // Resolve converters and allocate buffers for the given output types; character
+    // data is converted from encoding to UTF-8 and limited to max_lob_size bytes
+    OdbcRowset(const vector<LogicalType> &types, idx_t rowset_size, const std::string &encoding = "UTF-8",
+               idx_t max_lob_size = 0, bool lob_overflow_null = false);
+
+    // Destructor
+    ~OdbcRowset();
+
+    // Forbid copying and moving - the driver holds pointers into this object
+    OdbcRowset(const OdbcRowset &) = delete;
+    OdbcRowset &operator=(const OdbcRowset &) = delete;
+
+    // Check whether every output type has a bound-buffer converter
+    static bool Supports(const vector<LogicalType> &types);
+
+    // Register the fetch buffer setting
+    static void RegisterSettings(DBConfig &config);
+
+    // Fetch buffer budget of one rowset in bytes configured for the context (0 = no limit)
+    static idx_t GetBufferBudget(ClientContext &context);
+
+    // Limit the bound buffers to budget bytes (0 = no limit). With adaptive, the rowset size
+    // is no longer fixed to the requested size but adjusted between fetches (see Adapt).
+    void SetBufferBudget(idx_t budget, bool adaptive);
+
+    // Bind the buffers to an executed statement, using what the driver supports
+    void Bind(OdbcStatement &statement, const OdbcDriverInfo &driver);
+
+    // Release the bindings of the current statement
+    void Unbind();
+
+    // Fetch the next rowset, returns the number of rows (0 at the end of the result)
+    idx_t Fetch();
+
+    // Convert rows [offset, offset + count) of the current rowset into output, adding the
+    // time each column took to metrics (if given)
+    void Scan(DataChunk &output, idx_t offset, idx_t count, idx_t out_offset, OdbcScanMetrics *metrics = nullptr);
+
+    idx_t GetRowsetSize() const { return rowset_size; }
+
+    // Default budget of the odbc_fetch_buffer_mb setting
+    static constexpr idx_t DEFAULT_BUFFER_MB = 16;
+    // Bounds and initial size of adaptive rowsets
+    static constexpr idx_t MIN_ADAPTIVE_ROWSET_SIZE = 64;
+    static constexpr idx_t MAX_ADAPTIVE_ROWSET_SIZE = 65536;
+    // Round trip time adaptive rowsets are sized for: faster fetches of full rowsets grow the
+    // rowset, fetches that take several times longer shrink it
+    static constexpr uint64_t TARGET_FETCH_NS = 50000000;
+
+    // Widest string column that is bound; wider or unsized columns are read with SQLGetData
+    static constexpr idx_t MAX_BOUND_STRING_BYTES = 8192;
+    
+    // Stream the character or binary value of column_number in the current row with chunked
+    // SQLGetData calls into out[out_offset], applying the column's encoding and LOB limit.
+    // Also used by the row-by-row path for columns nanodbc leaves unbound.
+    static void ReadLongColumn(SQLHSTMT hstmt, SQLUSMALLINT column_number, OdbcColumnBuffer &column, Vector &out,
+                               idx_t out_offset);
+    
+    // Apply the column's LOB limit to a value that was read completely, shortening length;
+    // returns false if the value is to become NULL
+    static bool LimitLongValue(const OdbcColumnBuffer &column, const char *data, idx_t &length);
+
+private:
+    // Size the variable-width buffers from the described result columns and choose the
+    // rowset size from the row width, the buffer budget and the driver's capabilities
+    void DescribeColumns(SQLHSTMT handle, const OdbcDriverInfo &driver);
+    // Grow the buffers of all columns to rows rows, returns true if any buffer moved
+    bool Reserve(idx_t rows);
+    // Bind the column buffers to the statement (SQLBindCol)
+    void BindColumns();
+    // Set the rowset size for the following fetches, keeping the size the driver settled on
+    void SetRowArraySize(idx_t size);
+    // Pick the size of the next adaptive rowset from the last fetch
+    void Adapt(idx_t rows, uint64_t fetch_ns);
+    // Read the value of an unbound column in row of the current rowset straight into out
+    void ReadUnbound(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset);
+    // Re-read a bound string value that did not fit into its buffer
+    void RefetchTruncated(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset);
+    // Keep what the buffer holds of such a value when the driver cannot re-read it,
+    // applying the column's LOB overflow rule
+    void KeepTruncated(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset);
+
+    vector<OdbcColumnBuffer> columns;
+    unique_ptr<OdbcEncodingConverter> encoding_converter;
+    idx_t requested_rowset_size;
+    idx_t rowset_size;
+    // Largest rowset the budget and the requested size allow for the current result
+    idx_t max_rowset_size;
+    // Rows the column buffers have room for
+    idx_t allocated_rows = 0;
+    idx_t buffer_budget = 0;
+    bool adaptive = false;
+    // Size adaptive rowsets continue with in the next result of the scan
+    idx_t adaptive_size = STANDARD_VECTOR_SIZE;
+    // Rows and duration of the last fetch, resized from before the next one
+    idx_t last_rows = 0;
+    uint64_t last_fetch_ns = 0;
+    SQLHSTMT hstmt = nullptr;
+    SQLULEN rows_fetched = 0;
+    // SQLGetData on bound columns (SQL_GD_BOUND) and on rows of a block cursor (SQL_GD_BLOCK)
+    bool getdata_bound = false;
+    bool getdata_block = false;
+};
+
+} // namespace duckdb
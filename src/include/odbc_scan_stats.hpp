@@ -0,0 +1,119 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include <chrono>
+#include <deque>
+
+namespace duckdb {
+
+/**
+ * @brief Type classes conversion time is broken down by
+ */
+enum class OdbcTypeClass : uint8_t { NUMERIC = 0, STRING = 1, TEMPORAL = 2, OTHER = 3 };
+static constexpr idx_t ODBC_TYPE_CLASS_COUNT = 4;
+
+/**
+ * @brief Counters of one scan thread
+ * Times are in nanoseconds and sampled with the steady clock around driver
+ * calls and per-column conversions, never per value.
+ */
+struct OdbcScanMetrics {
+    // Acquiring connections (0 when the bind-time connection is reused)
+    uint64_t connect_ns = 0;
+    // Preparing and executing statements
+    uint64_t execute_ns = 0;
+    // From the start of the scan to the first row (0 until one arrived)
+    uint64_t first_row_ns = 0;
+    // Fetching rows from the driver
+    uint64_t fetch_ns = 0;
+    // Converting values into DuckDB vectors, by OdbcTypeClass
+    uint64_t convert_ns[ODBC_TYPE_CLASS_COUNT] = {};
+    idx_t rows = 0;
+    // Payload bytes of the returned values
+    idx_t bytes = 0;
+    // Round trips that returned rows (block cursor fetches)
+    idx_t rowsets = 0;
+
+    static OdbcTypeClass GetTypeClass(const LogicalType &type);
+
+    // Count the payload bytes of a filled chunk
+    void AddBytes(DataChunk &chunk);
+
+    // Add the counters of another thread of the same scan
+    void Merge(const OdbcScanMetrics &other);
+};
+
+/**
+ * @brief Steady-clock stopwatch
+ */
+class OdbcScanTimer {
+public:
+    OdbcScanTimer() : start(std::chrono::steady_clock::now()) {}
+
+    uint64_t ElapsedNanos() const {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief Adds the time a scope took to a counter, also when it is left by an exception
+ */
+class OdbcScopedTimer {
+public:
+    explicit OdbcScopedTimer(uint64_t &target_p) : target(target_p) {}
+    ~OdbcScopedTimer() { target += timer.ElapsedNanos(); }
+
+private:
+    uint64_t &target;
+    OdbcScanTimer timer;
+};
+
+/**
+ * @brief Counters of a finished (or running) scan, summed over its threads
+ */
+struct OdbcScanRecord {
+    idx_t scan_id = 0;
+    std::string function;
+    // Table or query text
+    std::string target;
+    idx_t threads = 0;
+    OdbcScanMetrics metrics;
+};
+
+/**
+ * @brief Recent scans of a database instance, read by odbc_scan_stats()
+ * Threads publish their counters once, when their scan state is destroyed.
+ */
+class OdbcScanStatsRegistry : public ObjectCacheEntry {
+public:
+    // Scans kept; older ones are dropped first
+    static constexpr idx_t MAX_RECORDS = 100;
+
+    static std::shared_ptr<OdbcScanStatsRegistry> Get(ClientContext &context);
+
+    // Start a record, returns its scan id
+    idx_t Register(std::string function, std::string target);
+
+    // Add the counters of one thread (ignored once the record was dropped)
+    void Merge(idx_t scan_id, const OdbcScanMetrics &metrics);
+
+    std::vector<OdbcScanRecord> GetRecords();
+
+    static std::string ObjectType() { return "odbc_scan_stats"; }
+    std::string GetObjectType() override { return ObjectType(); }
+
+private:
+    std::mutex lock;
+    std::deque<OdbcScanRecord> records;
+    idx_t next_scan_id = 1;
+};
+
+// odbc_scan_stats(): counters of the most recent scans
+TableFunction OdbcScanStatsFunction();
+
+} // namespace duckdb
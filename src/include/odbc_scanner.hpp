@@ -4,6 +4,12 @@
 #include "odbc_connection.hpp" 
 #include "odbc_statement.hpp"
 #include "odbc_parameters.hpp"
+#include "odbc_rowset.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_prefetch.hpp"
+#include "odbc_scan_stats.hpp"
+#include "odbc_result_cache.hpp"
+#include "duckdb/execution/expression_executor.hpp"
 #include <cmath>
 
 namespace duckdb {
@@ -27,7 +33,10 @@ struct OdbcScannerState : public TableFunctionData {
     
     // Operation details
     std::string table_name;
+    std::string schema_name;  // Remote schema of table_name (empty = connection default)
     std::string sql;
+    // Values bound to the parameter markers of sql (odbc_query only)
+    std::vector<Value> parameters;
     
     // Schema information
     std::vector<std::string> column_names;
@@ -36,7 +45,33 @@ struct OdbcScannerState : public TableFunctionData {
     // Options
     OdbcOptions options;
     
-    // Global shared connection (optional)
+    // Range partitioning for parallel scans (odbc_scan only). Each predicate
+    // selects one disjoint key range; an empty list means a single serial scan.
+    std::string partition_column;
+    std::vector<std::string> partition_predicates;
+    // Values of the parameter markers in each predicate (the range bounds)
+    std::vector<std::vector<Value>> partition_bounds;
+    // Read all ranges from one snapshot of the data source (see OdbcDialect::ExportSnapshotQuery)
+    bool snapshot = false;
+    
+    // DBMS name reported by the driver (selects the SQL dialect)
+    std::string dbms_name;
+    
+    // Estimated row count of the table for the optimizer (odbc_scan only, invalid if unknown)
+    optional_idx estimated_cardinality;
+    // The schema came from a cache entry without a row count, OdbcScanCardinality estimates it
+    bool cardinality_pending = false;
+    
+    // LIMIT / ORDER BY pushed into the generated query by the optimizer (odbc_scan only).
+    // The local LIMIT / TOP-N operator is kept, these only cut what the source sends.
+    optional_idx row_limit;
+    std::string order_by;
+    
+    // Column whose new values refresh a cached result (odbc_scan with cache = true only)
+    std::string cache_watermark;
+    
+    // Pooled connection used at bind time, handed on to the scan so that it does
+    // not have to connect again (moved out by InitOdbcGlobalState)
     std::shared_ptr<OdbcConnection> global_connection;
 };
 
@@ -44,14 +79,59 @@ struct OdbcScannerState : public TableFunctionData {
  * @brief Local scanner state for parallel execution
  */
 struct OdbcLocalScanState : public LocalTableFunctionState {
-    // Connection (owned or borrowed)
+    // Publishes the metrics to odbc_scan_stats()
+    ~OdbcLocalScanState() override;
+    
+    // Pooled connection (returned to the pool when the state is destroyed)
     std::shared_ptr<OdbcConnection> connection;
+    // Read-only transaction that imported the scan's snapshot (null unless snapshot = true).
+    // Rolled back after the statement is closed and before the connection goes back to the pool.
+    std::unique_ptr<nanodbc::transaction> snapshot_transaction;
+    // Taken from the connection's statement cache, goes back there when the scan moves on
     std::unique_ptr<OdbcStatement> statement;
     
+    // Column-wise bound fetch buffers (null when the row-by-row path is used)
+    std::unique_ptr<OdbcRowset> rowset;
+    bool rowset_bound = false;
+    idx_t rowset_offset = 0;
+    idx_t rowset_count = 0;
+    
+    // Converter for the row-by-row path when the source encoding is not UTF-8
+    std::unique_ptr<OdbcEncodingConverter> encoding_converter;
+    // LOB limit, encoding and reusable SQLGetData buffer of each output column on the
+    // row-by-row path (only used for character and binary columns)
+    std::vector<OdbcColumnBuffer> long_columns;
+    
+    // Evaluates the global residual filter on each chunk (null if there is none)
+    unique_ptr<ExpressionExecutor> filter_executor;
+    SelectionVector filter_sel {STANDARD_VECTOR_SIZE};
+    
     // Scan state
     bool done = false;
     std::vector<column_t> column_ids;
-    idx_t scan_count = 0;
+    // Rows read from the current statement (row-by-row path, counts rowsets)
+    idx_t statement_rows = 0;
+    
+    // Rows fetched from the source for the result cache (null unless the scan stores its result)
+    unique_ptr<ColumnDataCollection> cache_rows;
+    ColumnDataAppendState cache_append;
+    // Cached rows this thread returns before any remote rows (null once they are exhausted)
+    std::shared_ptr<const OdbcCachedResult> cached_rows;
+    idx_t cached_segment = 0;
+    ColumnDataScanState cached_scan;
+    
+    // Counters of this thread, merged into the scan's record by the destructor
+    OdbcScanMetrics metrics;
+    OdbcScanTimer scan_timer;
+    std::shared_ptr<OdbcScanStatsRegistry> stats_registry;
+    idx_t scan_id = 0;
+    
+    // Background fetcher (null when prefetching is disabled). While it runs, the
+    // fields above belong to its thread. Declared last so that it is stopped before
+    // the statement and connection it reads from are destroyed.
+    unique_ptr<OdbcPrefetcher> prefetcher;
+    // Prefetched chunk the current output references
+    unique_ptr<DataChunk> prefetched_chunk;
 };
 
 /**
@@ -64,6 +144,38 @@ struct OdbcGlobalScanState : public GlobalTableFunctionState {
     idx_t position = 0;
     idx_t max_thread_count;
     
+    // Range predicates still to be scanned, handed out in order via position
+    std::vector<std::string> partitions;
+    
+    // Connection left over from binding, taken by the first thread that needs one
+    std::shared_ptr<OdbcConnection> connection;
+    
+    // Snapshot the ranges of a partitioned scan read from (snapshot = true, empty otherwise).
+    // The exporting transaction has to stay open until every thread has imported it.
+    std::shared_ptr<OdbcConnection> snapshot_connection;
+    std::unique_ptr<nanodbc::transaction> snapshot_transaction;
+    std::string snapshot_id;
+    
+    // Filters that could not be sent to the data source, bound to the output columns
+    unique_ptr<Expression> residual_filter;
+    
+    // Record of this scan in odbc_scan_stats()
+    std::shared_ptr<OdbcScanStatsRegistry> stats_registry;
+    idx_t scan_id = 0;
+    
+    // Result cache (cache = true, null otherwise). The cached result is returned by the
+    // first thread; if the scan stores a result, the rows of each thread are collected in
+    // cache_segments and stored once the last of cache_threads has finished.
+    std::shared_ptr<OdbcResultCache> result_cache;
+    std::string cache_key;
+    std::shared_ptr<const OdbcCachedResult> cached_result;
+    bool cached_result_claimed = false;
+    bool cache_store = false;
+    // Watermark the rows of this scan were read up to
+    Value cache_watermark;
+    std::vector<std::shared_ptr<ColumnDataCollection>> cache_segments;
+    idx_t cache_threads = 0;
+    
     idx_t MaxThreads() const override {
         return max_thread_count;
     }
@@ -74,9 +186,22 @@ struct OdbcGlobalScanState : public GlobalTableFunctionState {
  */
 struct OdbcExecFunctionData : public TableFunctionData {
     ConnectionParams connection_params;
-    std::string sql;
+    std::vector<std::string> statements;
     OdbcOptions options;
-    bool finished = false;
+    bool transaction = false;
+};
+
+/**
+ * @brief Progress of odbc_exec
+ * Runs the statements in order on one pooled connection, one row per statement
+ */
+struct OdbcExecGlobalState : public GlobalTableFunctionState {
+    // Declared before the transaction so that it is rolled back before the
+    // connection goes back to the pool
+    std::shared_ptr<OdbcConnection> connection;
+    std::unique_ptr<nanodbc::transaction> transaction;
+    // Next statement to run
+    idx_t position = 0;
 };
 
 /**
@@ -106,6 +231,22 @@ unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context,
                                         vector<string> &names,
                                         OdbcOperation operation);
 
+// Quoted, schema-qualified name of the table of an odbc_scan
+std::string QuoteTableName(const OdbcScannerState &bind_data);
+
+// Optimizer statistics of odbc_scan
+unique_ptr<NodeStatistics> OdbcScanCardinality(ClientContext &context, const FunctionData *bind_data);
+unique_ptr<BaseStatistics> OdbcScanStatistics(ClientContext &context, const FunctionData *bind_data,
+                                              column_t column_id);
+
+// Streaming buffers with the LOB limit of each output column of the row-by-row path
+std::vector<OdbcColumnBuffer> CreateLongColumnBuffers(const vector<LogicalType> &types, const OdbcOptions &options,
+                                                      OdbcEncodingConverter *encoding_converter);
+
+// Convert one value of the current row of a nanodbc result (row-by-row path)
+void ConvertRowValue(OdbcStatement &statement, OdbcEncodingConverter *encoding_converter,
+                     std::vector<OdbcColumnBuffer> &long_columns, idx_t col_idx, Vector &out_vec, idx_t out_idx);
+
 // Main scan function for reading data
 void ScanOdbcSource(ClientContext &context, TableFunctionInput &data, DataChunk &output);
 
@@ -119,6 +260,7 @@ unique_ptr<LocalTableFunctionState> InitOdbcLocalState(ExecutionContext &context
 
 // Attach function for creating database views
 void AttachOdbcDatabase(ClientContext &context, TableFunctionInput &data, DataChunk &output);
+unique_ptr<GlobalTableFunctionState> InitOdbcExecState(ClientContext &context, TableFunctionInitInput &input);
 void ExecuteOdbcStatement(ClientContext &context, TableFunctionInput &data, DataChunk &output);
 
 // Function declarations for public API
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "odbc_connection.hpp"
+#include <chrono>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Result schema of a remote table or query as seen at bind time
+ */
+struct OdbcSchema {
+    std::vector<std::string> names;
+    std::vector<LogicalType> types;
+    // DBMS name reported by the driver (selects the SQL dialect)
+    std::string dbms_name;
+    // Estimated row count of a table (see OdbcStatistics::EstimateRowCount)
+    optional_idx cardinality;
+    // False while the row count has not been looked up yet (tables seeded by odbc_attach);
+    // the first plan that reads the table estimates it
+    bool cardinality_estimated = true;
+};
+
+/**
+ * @brief Bind-time schema cache for one database instance
+ * Remembers the columns of tables (SQLColumns) and queries (SQLDescribeCol) per
+ * data source, so that repeated binds - e.g. every use of an attached view - skip
+ * the catalog round trips. Entries expire after odbc_schema_cache_ttl seconds.
+ */
+class OdbcSchemaCache : public ObjectCacheEntry {
+public:
+    // Default lifetime of an entry, overridable with the odbc_schema_cache_ttl setting (0 disables caching)
+    static constexpr idx_t DEFAULT_TTL_SECONDS = 300;
+
+    // Get the cache of the context's database, with the current TTL applied
+    static std::shared_ptr<OdbcSchemaCache> Get(ClientContext &context);
+
+    // Register the cache settings
+    static void RegisterSettings(DBConfig &config);
+
+    // Cache keys of a table and a query of a data source
+    static std::string TableKey(const ConnectionParams &params, const std::string &table_name, bool all_varchar);
+    static std::string QueryKey(const ConnectionParams &params, const std::string &query, bool all_varchar);
+
+    // Copy a live entry into schema, returns false on a miss
+    bool Lookup(const std::string &key, OdbcSchema &schema);
+
+    // Remember a schema (ignored while caching is disabled)
+    void Store(const std::string &key, OdbcSchema schema);
+
+    
+    // Drop all entries, returns how many there were
+    idx_t Clear();
+
+    void SetTTL(idx_t ttl_seconds);
+
+    static std::string ObjectType() { return "odbc_schema_cache"; }
+    std::string GetObjectType() override { return ObjectType(); }
+
+private:
+    template <class T>
+    struct CachedEntry {
+        T value;
+        std::chrono::steady_clock::time_point stored;
+    };
+    
+    template <class T>
+    bool LookupEntry(std::unordered_map<std::string, CachedEntry<T>> &map, const std::string &key, T &value);
+    template <class T>
+    void StoreEntry(std::unordered_map<std::string, CachedEntry<T>> &map, const std::string &key, T value);
+
+    std::mutex lock;
+    std::unordered_map<std::string, CachedEntry<OdbcSchema>> entries;
+    idx_t ttl_seconds = DEFAULT_TTL_SECONDS;
+};
+
+// odbc_clear_cache(): drop all cached schemas and scan results
+TableFunction OdbcClearCacheFunction();
+
+} // namespace duckdb
@@ -2,6 +2,7 @@
 
 #include "duckdb.hpp"
 #include "odbc_headers.hpp"
+#include <map>
 
 namespace duckdb {
 
@@ -31,15 +32,39 @@ public:
     // Execute and fetch next row
     bool Step();
     
+    // Execute without creating a nanodbc result (for callers that bind their own buffers)
+    void Execute();
+    bool IsExecuted() const { return executed; }
+    
+    // Execute once for row_count parameter sets bound as column-wise arrays
+    void ExecuteBatch(idx_t row_count);
+    
+    // Number of rows the driver fetches per round trip (block cursor size)
+    void SetRowsetSize(idx_t size);
+    idx_t GetRowsetSize() const { return rowset_size; }
+    
+    // Seconds the driver lets each execution run (SQL_ATTR_QUERY_TIMEOUT, 0 = no limit)
+    void SetQueryTimeout(idx_t seconds);
+    
     // Reset statement for re-execution
     void Reset();
     
+    // Close the cursor and drop column bindings and parameters, keeping the prepared plan so
+    // that the statement can be executed again. Returns false if the driver rejected it.
+    bool Recycle();
+    
+    // SQL text the statement was prepared with
+    const std::string &GetQuery() const { return query; }
+    
     // Close statement and free resources
     void Close();
     
     // Check if statement is open
     bool IsOpen() const;
     
+    // Get the native ODBC statement handle
+    SQLHSTMT GetNativeHandle() const { return static_cast<SQLHSTMT>(stmt.native_statement_handle()); }
+    
     // Get metadata
     SQLSMALLINT GetOdbcType(idx_t colIdx, SQLULEN* columnSize = nullptr, SQLSMALLINT* decimalDigits = nullptr);
     std::string GetName(idx_t colIdx);
@@ -47,10 +72,23 @@ public:
     
     // Get value from result
     bool IsNull(idx_t colIdx) const;
+    // False for long-data columns the result reads with SQLGetData (IsNull is only valid after a Get)
+    bool IsBound(idx_t colIdx) const;
     std::string GetString(idx_t colIdx);
+    // Read into out, reusing its capacity across rows
+    void GetString(idx_t colIdx, std::string &out);
+    // Value of a bound column in the current row as it is held in the result's rowset buffer,
+    // without conversion or copy. Returns null for unbound columns; c_type is the C type the
+    // column is bound as, length its length/indicator value and capacity the buffer size per row.
+    const char *GetBoundData(idx_t colIdx, SQLSMALLINT &c_type, SQLLEN &length, SQLLEN &capacity) const;
+    // Read the whole character value of the current row with SQLGetData as c_type (SQL_C_CHAR or
+    // SQL_C_WCHAR, converted to UTF-8), e.g. when it did not fit into the bound buffer
+    void GetDataString(idx_t colIdx, SQLSMALLINT c_type, std::string &out);
     int32_t GetInt32(idx_t colIdx);
     int64_t GetInt64(idx_t colIdx);
     double GetDouble(idx_t colIdx);
+    date_t GetDate(idx_t colIdx);
+    dtime_t GetTime(idx_t colIdx);
     timestamp_t GetTimestamp(idx_t colIdx);
     
     // Bind parameter values
@@ -64,13 +102,33 @@ public:
     // Simplified binding from vector
     void BindValue(Vector &col, idx_t colIdx, idx_t rowIdx);
     
+    // Bind a constant; types without a matching C type are sent as text
+    void BindParameter(idx_t colIdx, const Value &value);
+    
     // Make result accessible to scanner
     nanodbc::statement stmt;
     nanodbc::result result;
     
 private:
+    // Describe a result column of the prepared statement without executing it
+    // (SQLDescribeCol), returns false if the driver cannot describe it yet
+    bool DescribeColumn(idx_t colIdx, std::string &name, SQLSMALLINT &type, SQLULEN &size, SQLSMALLINT &digits);
+    
+    std::string query;
     bool has_result = false;
     bool executed = false;
+    idx_t rowset_size = 1;
+    idx_t query_timeout = 0;
+    
+    // Storage for single bound parameter values - the driver reads them through
+    // the bound pointers at execute time, so they must outlive the Bind* call
+    struct BoundParameter {
+        int32_t int32_value = 0;
+        int64_t int64_value = 0;
+        double double_value = 0;
+        std::string string_value;
+    };
+    std::map<idx_t, BoundParameter> parameters;
 };
 
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "odbc_connection.hpp"
+
+namespace duckdb {
+
+struct OdbcScannerState;
+
+/**
+ * @brief Optimizer statistics of remote tables
+ * Row counts come from the driver's catalog (SQLStatistics), a per-dialect
+ * statistics view or, if enabled, COUNT(*), and are kept in the schema cache, so a
+ * warm bind costs no round trip. Column value ranges are opt-in and read per query.
+ */
+class OdbcStatistics {
+public:
+    // Register the statistics settings
+    static void RegisterSettings(DBConfig &config);
+
+    // Estimated row count of a table, invalid if the data source does not know it.
+    // Never throws - estimates only steer the optimizer.
+    static optional_idx EstimateRowCount(ClientContext &context, OdbcConnection &db, const std::string &dbms_name,
+                                         const std::string &schema_name, const std::string &table_name);
+
+    // Min/max statistics of a scanned column (null unless odbc_column_statistics is enabled)
+    static unique_ptr<BaseStatistics> GetColumnStatistics(ClientContext &context, const OdbcScannerState &bind_data,
+                                                          column_t column_id);
+};
+
+} // namespace duckdb
@@ -23,6 +23,10 @@ public:
     static LogicalType OdbcTypeToLogicalType(SQLSMALLINT odbcType, SQLULEN columnSize, SQLSMALLINT decimalDigits);
     static SQLSMALLINT LogicalTypeToOdbcType(const LogicalType& type);
     
+    // Parse the text form of a DECIMAL value into row of a DECIMAL vector (exact, no double round trip)
+    static bool ParseDecimal(const std::string& text, Vector& out, idx_t row);
+    static bool ParseDecimal(const char* data, idx_t length, Vector& out, idx_t row);
+    
     // Helper methods for data handling
     static bool IsBinaryType(SQLSMALLINT sqlType);
     static bool ReadVarData(nanodbc::result& result, idx_t colIdx, bool& isNull, std::vector<char>& output);
@@ -1789,7 +1789,8 @@ public:
         // so only raise the error if a non-default timeout was requested.
         try
         {
-            this->set_attribute(SQL_ATTR_QUERY_TIMEOUT, 0, &timeout);
+            // The attribute is passed by value, not through a pointer
+            this->set_attribute(SQL_ATTR_QUERY_TIMEOUT, 0, (const void*)(std::intptr_t)timeout);
         }
         catch (...)
         {
@@ -1999,6 +2000,18 @@ public:
         return {statement, batch_operations};
     }
 
+    result execute(batch_ops const& array_sizes, long timeout, statement& statement)
+    {
+#ifdef NANODBC_ENABLE_WORKAROUND_NODATA
+        const RETCODE rc = just_execute(array_sizes.parameter_array_length, timeout, statement);
+        if (rc == SQL_NO_DATA)
+            return result();
+#else
+        just_execute(array_sizes.parameter_array_length, timeout, statement);
+#endif
+        return {statement, array_sizes.rowset_size};
+    }
+
     RETCODE just_execute(
         long batch_operations,
         long timeout,
@@ -3615,6 +3628,26 @@ public:
         return is_bound(column);
     }
 
+    const char* bound_data(short column, short& ctype, long long& length, long long& capacity) const
+    {
+        throw_if_column_is_out_of_range(column);
+        bound_column& col = bound_columns_[column];
+        if (rowset_position_ >= rows())
+            throw index_range_error();
+        ctype = col.ctype_;
+        length = col.cbdata_[static_cast<size_t>(rowset_position_)];
+        capacity = col.clen_;
+        if (!col.bound_)
+            return nullptr;
+        return col.pdata_ + rowset_position_ * col.clen_;
+    }
+
+    void select_current_row()
+    {
+        if (rowset_size_ > 1)
+            set_current_position();
+    }
+
     short column(string const& column_name) const
     {
         auto i = bound_columns_by_name_.find(column_name);
@@ -5583,6 +5616,11 @@ result statement::execute(long batch_operations, long timeout)
     return impl_->execute(batch_operations, timeout, *this);
 }
 
+result statement::execute(batch_ops const& array_sizes, long timeout)
+{
+    return impl_->execute(array_sizes, timeout, *this);
+}
+
 void statement::just_execute(long batch_operations, long timeout)
 {
     impl_->just_execute(batch_operations, timeout, *this);
@@ -7282,6 +7320,16 @@ bool result::is_bound(string const& column_name) const
     return impl_->is_bound(column_name);
 }
 
+const char* result::bound_data(short column, short& ctype, long long& length, long long& capacity) const
+{
+    return impl_->bound_data(column, ctype, length, capacity);
+}
+
+void result::select_current_row()
+{
+    impl_->select_current_row();
+}
+
 short result::column(string const& column_name) const
 {
     return impl_->column(column_name);
@@ -7428,7 +7476,8 @@ template void result::get_ref(short, long long int&) const;
 template void result::get_ref(short, unsigned long long int&) const;
 template void result::get_ref(short, float&) const;
 template void result::get_ref(short, double&) const;
-template void result::get_ref(short, string&) const;
+template void result::get_ref(short, std::string&) const;
+template void result::get_ref(short, wide_string&) const;
 template void result::get_ref(short, date&) const;
 template void result::get_ref(short, time&) const;
 template void result::get_ref(short, timestamp&) const;
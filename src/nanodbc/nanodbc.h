@@ -1076,6 +1076,15 @@ public:
     /// \see open(), prepare(), result, transaction
     class result execute(long batch_operations = 1, long timeout = 0);
 
+    /// \brief Execute the previously prepared query now.
+    /// \param array_sizes Number of parameter sets to process and rows to fetch per rowset,
+    ///                    set independently of each other.
+    /// \param timeout The number in seconds before query timeout. Default 0 meaning no timeout.
+    /// \throws database_error
+    /// \return A result set object.
+    /// \see open(), prepare(), result, transaction
+    class result execute(batch_ops const& array_sizes, long timeout = 0);
+
     /// \brief Execute the previously prepared query now without constructing result object.
     /// \param batch_operations Rows to fetch per rowset, or number of batch parameters to process.
     /// \param timeout The number in seconds before query timeout. Default 0 meaning no timeout.
@@ -1976,6 +1985,21 @@ public:
     /// \throws index_range_error
     bool is_bound(string const& column_name) const;
 
+    /// \brief Returns the bound buffer of the given column in the current row without conversion.
+    ///
+    /// Columns are numbered from left to right and 0-indexed.
+    /// \param column position.
+    /// \param ctype receives the C type the column is bound as.
+    /// \param length receives the length/indicator value of the column in the current row.
+    /// \param capacity receives the size of the column's buffer per row in bytes.
+    /// \return Pointer into the rowset buffer, or nullptr if the column is not bound.
+    /// \throws index_range_error
+    const char* bound_data(short column, short& ctype, long long& length, long long& capacity) const;
+
+    /// \brief Positions the block cursor on the current row (SQLSetPos) for SQLGetData.
+    /// \throws database_error
+    void select_current_row();
+
     /// \brief Returns the column number of the specified column name.
     ///
     /// Columns are numbered from left to right and 0-indexed.
@@ -3,9 +3,21 @@
 #include "nanodbc_extension.hpp"
 #include "duckdb.hpp"
 #include "odbc_scanner.hpp"
+#include "odbc_insert.hpp"
+#include "odbc_lookup.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_prefetch.hpp"
+#include "odbc_schema_cache.hpp"
+#include "odbc_result_cache.hpp"
+#include "odbc_optimizer.hpp"
+#include "odbc_catalog.hpp"
+#include "odbc_statistics.hpp"
+#include "odbc_scan_stats.hpp"
+#include "odbc_driver_info.hpp"
 
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/main/extension_util.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
 namespace duckdb {
@@ -16,12 +28,32 @@ static void RegisterOdbcFunctions(DatabaseInstance &instance) {
     ExtensionUtil::RegisterFunction(instance, OdbcAttachFunction());
     ExtensionUtil::RegisterFunction(instance, OdbcQueryFunction());
     ExtensionUtil::RegisterFunction(instance, OdbcExecFunction());
+    ExtensionUtil::RegisterFunction(instance, OdbcInsertFunction());
+    ExtensionUtil::RegisterFunction(instance, OdbcLookupFunction());
+    ExtensionUtil::RegisterFunction(instance, OdbcClearCacheFunction());
+    ExtensionUtil::RegisterFunction(instance, OdbcScanStatsFunction());
+    ExtensionUtil::RegisterFunction(instance, OdbcDriverInfoFunction());
 }
 
 static void LoadInternal(DatabaseInstance &instance) {
     // Register the ODBC functions
     RegisterOdbcFunctions(instance);
+    
+    // Register the connection pool, prefetch, cache and statistics settings
+    auto &config = DBConfig::GetConfig(instance);
+    OdbcConnectionPool::RegisterSettings(config);
+    OdbcPrefetcher::RegisterSettings(config);
+    OdbcSchemaCache::RegisterSettings(config);
+    OdbcResultCache::RegisterSettings(config);
+    OdbcStatistics::RegisterSettings(config);
+    OdbcRowset::RegisterSettings(config);
+    OdbcOptimizer::RegisterSettings(config);
+    
+    // Push LIMIT / TOP-N and aggregates into odbc_scan queries
+    OdbcOptimizer::Register(config);
 
+    // ATTACH '<dsn or connection string>' AS name (TYPE odbc)
+    config.storage_extensions["odbc"] = make_uniq<OdbcStorageExtension>();
 }
 
 void NanodbcExtension::Load(DuckDB &db) {
@@ -0,0 +1,122 @@
+#include "odbc_cancel.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// OdbcCancelWatchdog
+//------------------------------------------------------------------------------
+
+std::shared_ptr<OdbcCancelWatchdog> OdbcCancelWatchdog::Get(ClientContext &context) {
+    return ObjectCache::GetObjectCache(context).GetOrCreate<OdbcCancelWatchdog>(ObjectType());
+}
+
+OdbcCancelWatchdog::~OdbcCancelWatchdog() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopped = true;
+    }
+    wake.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+idx_t OdbcCancelWatchdog::Register(ClientContext &context, SQLHSTMT handle, idx_t timeout_seconds) {
+    WatchedCall call;
+    call.context = &context;
+    call.handle = handle;
+    call.has_deadline = timeout_seconds > 0;
+    call.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_seconds);
+    call.reason = OdbcCancelReason::NONE;
+
+    lock_guard<mutex> guard(lock);
+    auto id = next_id++;
+    calls.emplace(id, call);
+    if (!thread.joinable()) {
+        thread = std::thread([this]() { Run(); });
+    } else if (calls.size() == 1) {
+        wake.notify_one();
+    }
+    return id;
+}
+
+OdbcCancelReason OdbcCancelWatchdog::Unregister(idx_t id) {
+    lock_guard<mutex> guard(lock);
+    auto entry = calls.find(id);
+    if (entry == calls.end()) {
+        return OdbcCancelReason::NONE;
+    }
+    auto reason = entry->second.reason;
+    calls.erase(entry);
+    return reason;
+}
+
+void OdbcCancelWatchdog::Run() {
+    unique_lock<mutex> guard(lock);
+    while (!stopped) {
+        if (calls.empty()) {
+            wake.wait(guard, [this]() { return stopped || !calls.empty(); });
+            continue;
+        }
+        wake.wait_for(guard, std::chrono::milliseconds(POLL_INTERVAL_MS));
+
+        // SQLCancel may be called from another thread while the call runs. The lock keeps
+        // the handle valid: the call's owner unregisters it before the statement is freed.
+        auto now = std::chrono::steady_clock::now();
+        for (auto &entry : calls) {
+            auto &call = entry.second;
+            if (call.reason != OdbcCancelReason::NONE) {
+                continue;
+            }
+            if (call.context->interrupted) {
+                call.reason = OdbcCancelReason::INTERRUPTED;
+            } else if (call.has_deadline && now >= call.deadline) {
+                call.reason = OdbcCancelReason::TIMEOUT;
+            } else {
+                continue;
+            }
+            SQLCancel(call.handle);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// OdbcCancelGuard
+//------------------------------------------------------------------------------
+
+OdbcCancelGuard::OdbcCancelGuard(ClientContext &context, SQLHSTMT handle, idx_t timeout_seconds_p,
+                                 const char *timeout_option_p)
+    : timeout_seconds(timeout_seconds_p), timeout_option(timeout_option_p) {
+    if (context.interrupted) {
+        throw InterruptException();
+    }
+    watchdog = OdbcCancelWatchdog::Get(context);
+    id = watchdog->Register(context, handle, timeout_seconds);
+}
+
+OdbcCancelGuard::~OdbcCancelGuard() {
+    Finish();
+}
+
+void OdbcCancelGuard::Finish() {
+    if (!finished) {
+        reason = watchdog->Unregister(id);
+        finished = true;
+    }
+}
+
+void OdbcCancelGuard::ThrowIfCancelled() {
+    Finish();
+    switch (reason) {
+        case OdbcCancelReason::INTERRUPTED:
+            throw InterruptException();
+        case OdbcCancelReason::TIMEOUT:
+            throw InvalidInputException("ODBC call cancelled after %llu seconds (%s)", timeout_seconds,
+                                        timeout_option);
+        default:
+            return;
+    }
+}
+
+} // namespace duckdb
@@ -0,0 +1,541 @@
+#include "odbc_catalog.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_scanner.hpp"
+#include "odbc_statistics.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/parser/constraints/not_null_constraint.hpp"
+#include "duckdb/parser/parsed_data/attach_info.hpp"
+#include "duckdb/parser/parsed_data/create_schema_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_info.hpp"
+#include "duckdb/storage/database_size.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+#include <unordered_set>
+
+namespace duckdb {
+
+static NotImplementedException ReadOnlyError() {
+    return NotImplementedException("Attached ODBC databases are read-only - use odbc_exec or odbc_insert to "
+                                   "modify the data source");
+}
+
+//------------------------------------------------------------------------------
+// OdbcTableEntry
+//------------------------------------------------------------------------------
+
+OdbcTableEntry::OdbcTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
+                               std::string remote_schema_p)
+    : TableCatalogEntry(catalog, schema, info), remote_schema(std::move(remote_schema_p)) {
+}
+
+unique_ptr<BaseStatistics> OdbcTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
+    return nullptr;
+}
+
+TableFunction OdbcTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
+    auto &odbc_catalog = catalog.Cast<OdbcCatalog>();
+
+    // Same bind data odbc_scan builds, from the column list read at lookup time
+    auto result = make_uniq<OdbcScannerState>();
+    result->connection_params = odbc_catalog.GetConnectionParams();
+    result->options = odbc_catalog.GetOptions();
+    result->table_name = name;
+    result->schema_name = remote_schema;
+    result->dbms_name = odbc_catalog.GetDbmsName();
+    for (auto &column : columns.Logical()) {
+        result->column_names.push_back(column.GetName());
+        result->column_types.push_back(column.GetType());
+    }
+
+    {
+        lock_guard<mutex> guard(cardinality_lock);
+        if (!cardinality_loaded) {
+            try {
+                auto connection = odbc_catalog.GetConnection();
+                cardinality = OdbcStatistics::EstimateRowCount(context, *connection, result->dbms_name,
+                                                               remote_schema, name);
+            } catch (const std::exception &) {
+                // Connection failures surface when the scan starts
+            }
+            cardinality_loaded = true;
+        }
+        result->estimated_cardinality = cardinality;
+    }
+
+    bind_data = std::move(result);
+    return OdbcScanFunction();
+}
+
+TableStorageInfo OdbcTableEntry::GetStorageInfo(ClientContext &context) {
+    return TableStorageInfo();
+}
+
+//------------------------------------------------------------------------------
+// OdbcSchemaEntry
+//------------------------------------------------------------------------------
+
+OdbcSchemaEntry::OdbcSchemaEntry(Catalog &catalog, CreateSchemaInfo &info, std::string remote_schema_p)
+    : SchemaCatalogEntry(catalog, info), remote_schema(std::move(remote_schema_p)) {
+}
+
+OdbcTableEntry &OdbcSchemaEntry::AddTable(const OdbcTableInfo &table) {
+    auto key = StringUtil::Lower(table.name);
+    auto existing = tables.find(key);
+    if (existing != tables.end()) {
+        return *existing->second;
+    }
+
+    CreateTableInfo info(catalog.GetName(), name, table.name);
+    for (idx_t i = 0; i < table.columns.size(); i++) {
+        auto &column = table.columns[i];
+        info.columns.AddColumn(ColumnDefinition(column.name, column.type));
+        if (column.not_null) {
+            info.constraints.push_back(make_uniq<NotNullConstraint>(LogicalIndex(i)));
+        }
+    }
+
+    auto entry = make_uniq<OdbcTableEntry>(catalog, *this, info, table.schema);
+    auto &result = *entry;
+    tables[key] = std::move(entry);
+    return result;
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::GetEntry(CatalogTransaction transaction, CatalogType type,
+                                                     const string &entry_name) {
+    if (type != CatalogType::TABLE_ENTRY && type != CatalogType::VIEW_ENTRY) {
+        return nullptr;
+    }
+
+    lock_guard<mutex> guard(lock);
+    auto entry = tables.find(StringUtil::Lower(entry_name));
+    if (entry != tables.end()) {
+        return entry->second.get();
+    }
+    if (fully_loaded) {
+        return nullptr;
+    }
+
+    // First reference - read the column list of just this table. The name is a
+    // search pattern, so only an exact (case-insensitive) match counts.
+    auto &odbc_catalog = catalog.Cast<OdbcCatalog>();
+    std::vector<OdbcTableInfo> found;
+    try {
+        auto connection = odbc_catalog.GetConnection();
+        found = connection->GetColumns(remote_schema, entry_name, odbc_catalog.GetOptions().all_varchar);
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("look up table '" + entry_name + "'", e);
+    }
+
+    const OdbcTableInfo *match = nullptr;
+    for (auto &table : found) {
+        if (table.columns.empty() || !StringUtil::CIEquals(table.name, entry_name)) {
+            continue;
+        }
+        // Without a schema filter the name may exist in several schemas
+        if (match && match->schema != table.schema) {
+            throw BinderException("Table \"%s\" exists in several schemas of ODBC database \"%s\" (\"%s\", "
+                                  "\"%s\", ...) - qualify it with the schema name",
+                                  entry_name, catalog.GetName(), match->schema, table.schema);
+        }
+        if (!match) {
+            match = &table;
+        }
+    }
+    return match ? &AddTable(*match) : nullptr;
+}
+
+void OdbcSchemaEntry::Scan(ClientContext &context, CatalogType type,
+                           const std::function<void(CatalogEntry &)> &callback) {
+    if (type != CatalogType::TABLE_ENTRY) {
+        return;
+    }
+
+    lock_guard<mutex> guard(lock);
+    if (!fully_loaded) {
+        // Listing the schema reads all column lists with a single SQLColumns call
+        auto &odbc_catalog = catalog.Cast<OdbcCatalog>();
+        try {
+            auto connection = odbc_catalog.GetConnection();
+            auto found = connection->GetColumns(remote_schema, std::string(), odbc_catalog.GetOptions().all_varchar);
+            // Names found in more than one schema are ambiguous unqualified, so they are left out
+            // (only possible without a schema filter)
+            std::unordered_map<std::string, std::string> schema_of;
+            std::unordered_set<std::string> ambiguous;
+            for (auto &table : found) {
+                auto key = StringUtil::Lower(table.name);
+                auto entry = schema_of.emplace(key, table.schema);
+                if (!entry.second && entry.first->second != table.schema) {
+                    ambiguous.insert(key);
+                }
+            }
+            for (auto &table : found) {
+                if (!table.columns.empty() && ambiguous.find(StringUtil::Lower(table.name)) == ambiguous.end()) {
+                    AddTable(table);
+                }
+            }
+        } catch (const nanodbc::database_error &e) {
+            OdbcUtils::ThrowException("list tables of schema '" + name + "'", e);
+        }
+        fully_loaded = true;
+    }
+
+    for (auto &entry : tables) {
+        callback(*entry.second);
+    }
+}
+
+void OdbcSchemaEntry::Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) {
+    if (type != CatalogType::TABLE_ENTRY) {
+        return;
+    }
+
+    // Only the tables that have been resolved so far
+    lock_guard<mutex> guard(lock);
+    for (auto &entry : tables) {
+        callback(*entry.second);
+    }
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateTable(CatalogTransaction transaction, BoundCreateTableInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateFunction(CatalogTransaction transaction, CreateFunctionInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateIndex(CatalogTransaction transaction, CreateIndexInfo &info,
+                                                        TableCatalogEntry &table) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateView(CatalogTransaction transaction, CreateViewInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateSequence(CatalogTransaction transaction, CreateSequenceInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateTableFunction(CatalogTransaction transaction,
+                                                                CreateTableFunctionInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateCopyFunction(CatalogTransaction transaction,
+                                                               CreateCopyFunctionInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreatePragmaFunction(CatalogTransaction transaction,
+                                                                 CreatePragmaFunctionInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateCollation(CatalogTransaction transaction, CreateCollationInfo &info) {
+    throw ReadOnlyError();
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateType(CatalogTransaction transaction, CreateTypeInfo &info) {
+    throw ReadOnlyError();
+}
+
+void OdbcSchemaEntry::DropEntry(ClientContext &context, DropInfo &info) {
+    throw ReadOnlyError();
+}
+
+void OdbcSchemaEntry::Alter(CatalogTransaction transaction, AlterInfo &info) {
+    throw ReadOnlyError();
+}
+
+//------------------------------------------------------------------------------
+// OdbcCatalog
+//------------------------------------------------------------------------------
+
+OdbcCatalog::OdbcCatalog(AttachedDatabase &db, ConnectionParams connection_params_p, OdbcOptions options_p,
+                         std::shared_ptr<OdbcConnectionPool> pool_p, std::string dbms_name_p,
+                         std::string default_schema_p)
+    : Catalog(db), connection_params(std::move(connection_params_p)), options(std::move(options_p)),
+      pool(std::move(pool_p)), dbms_name(std::move(dbms_name_p)), default_schema(std::move(default_schema_p)) {
+}
+
+void OdbcCatalog::Initialize(bool load_builtin) {
+    GetOrCreateSchema(DEFAULT_SCHEMA);
+}
+
+OdbcSchemaEntry &OdbcCatalog::GetOrCreateSchema(const std::string &schema_name) {
+    lock_guard<mutex> guard(lock);
+    auto key = StringUtil::Lower(schema_name);
+    auto entry = schemas.find(key);
+    if (entry != schemas.end()) {
+        return *entry->second;
+    }
+
+    // "main" maps to the connection's default schema
+    CreateSchemaInfo info;
+    info.schema = schema_name;
+    auto remote_schema = key == DEFAULT_SCHEMA ? default_schema : schema_name;
+    auto schema = make_uniq<OdbcSchemaEntry>(*this, info, remote_schema);
+    auto &result = *schema;
+    schemas[key] = std::move(schema);
+    return result;
+}
+
+void OdbcCatalog::LoadSchemas() {
+    {
+        lock_guard<mutex> guard(lock);
+        if (schemas_loaded) {
+            return;
+        }
+    }
+
+    std::list<std::string> remote_schemas;
+    try {
+        auto connection = GetConnection();
+        nanodbc::catalog catalog(connection->GetNativeConnection());
+        remote_schemas = catalog.list_schemas();
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("list schemas", e);
+    }
+    for (auto &remote_schema : remote_schemas) {
+        if (!remote_schema.empty()) {
+            GetOrCreateSchema(remote_schema);
+        }
+    }
+
+    lock_guard<mutex> guard(lock);
+    schemas_loaded = true;
+}
+
+optional_ptr<SchemaCatalogEntry> OdbcCatalog::GetSchema(CatalogTransaction transaction, const string &schema_name,
+                                                        OnEntryNotFound if_not_found,
+                                                        QueryErrorContext error_context) {
+    if (schema_name.empty() || StringUtil::CIEquals(schema_name, DEFAULT_SCHEMA)) {
+        return &GetOrCreateSchema(DEFAULT_SCHEMA);
+    }
+
+    // Unknown names read the remote schema list (once) before giving up
+    LoadSchemas();
+
+    lock_guard<mutex> guard(lock);
+    auto entry = schemas.find(StringUtil::Lower(schema_name));
+    if (entry != schemas.end()) {
+        return entry->second.get();
+    }
+    if (if_not_found == OnEntryNotFound::RETURN_NULL) {
+        return nullptr;
+    }
+    throw BinderException("Schema with name \"%s\" does not exist in ODBC database \"%s\"", schema_name, GetName());
+}
+
+void OdbcCatalog::ScanSchemas(ClientContext &context, std::function<void(SchemaCatalogEntry &)> callback) {
+    LoadSchemas();
+
+    vector<reference<OdbcSchemaEntry>> entries;
+    {
+        lock_guard<mutex> guard(lock);
+        for (auto &entry : schemas) {
+            entries.push_back(*entry.second);
+        }
+    }
+    for (auto &entry : entries) {
+        callback(entry.get());
+    }
+}
+
+std::shared_ptr<OdbcConnection> OdbcCatalog::GetConnection() {
+    return pool->AcquireConnection(connection_params);
+}
+
+optional_ptr<CatalogEntry> OdbcCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) {
+    throw ReadOnlyError();
+}
+
+void OdbcCatalog::DropSchema(ClientContext &context, DropInfo &info) {
+    throw ReadOnlyError();
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanCreateTableAs(ClientContext &context, LogicalCreateTable &op,
+                                                            unique_ptr<PhysicalOperator> plan) {
+    throw ReadOnlyError();
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanInsert(ClientContext &context, LogicalInsert &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+    throw ReadOnlyError();
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanDelete(ClientContext &context, LogicalDelete &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+    throw ReadOnlyError();
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanUpdate(ClientContext &context, LogicalUpdate &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+    throw ReadOnlyError();
+}
+
+unique_ptr<LogicalOperator> OdbcCatalog::BindCreateIndex(Binder &binder, CreateStatement &stmt,
+                                                         TableCatalogEntry &table, unique_ptr<LogicalOperator> plan) {
+    throw ReadOnlyError();
+}
+
+DatabaseSize OdbcCatalog::GetDatabaseSize(ClientContext &context) {
+    DatabaseSize size;
+    size.total_blocks = 0;
+    size.block_size = 0;
+    size.free_blocks = 0;
+    size.used_blocks = 0;
+    size.bytes = 0;
+    size.wal_size = 0;
+    return size;
+}
+
+string OdbcCatalog::GetDBPath() {
+    // Connection strings can contain credentials, so only a DSN is shown
+    return connection_params.GetDsn();
+}
+
+//------------------------------------------------------------------------------
+// OdbcTransactionManager
+//------------------------------------------------------------------------------
+
+Transaction &OdbcTransactionManager::StartTransaction(ClientContext &context) {
+    auto transaction = make_uniq<OdbcTransaction>(*this, context);
+    auto &result = *transaction;
+    lock_guard<mutex> guard(transaction_lock);
+    transactions[result] = std::move(transaction);
+    return result;
+}
+
+ErrorData OdbcTransactionManager::CommitTransaction(ClientContext &context, Transaction &transaction) {
+    lock_guard<mutex> guard(transaction_lock);
+    transactions.erase(transaction);
+    return ErrorData();
+}
+
+void OdbcTransactionManager::RollbackTransaction(Transaction &transaction) {
+    lock_guard<mutex> guard(transaction_lock);
+    transactions.erase(transaction);
+}
+
+//------------------------------------------------------------------------------
+// OdbcStorageExtension
+//------------------------------------------------------------------------------
+
+static unique_ptr<Catalog> OdbcAttach(StorageExtensionInfo *storage_info, ClientContext &context,
+                                      AttachedDatabase &db, const string &name, AttachInfo &info,
+                                      AccessMode access_mode) {
+    std::string username;
+    std::string password;
+    int timeout = 60;
+    SQLUINTEGER isolation = 0;
+    OdbcOptions options;
+    // Query returning the default schema (default: the one of the recognized DBMS)
+    std::string schema_query;
+    bool has_schema_query = false;
+
+    for (auto &entry : info.options) {
+        auto option = StringUtil::Lower(entry.first);
+        if (option == "type" || option == "read_only" || option == "readonly" || option == "access_mode") {
+            // Handled by DuckDB
+            continue;
+        } else if (option == "username") {
+            username = entry.second.ToString();
+        } else if (option == "password") {
+            password = entry.second.ToString();
+        } else if (option == "timeout") {
+            timeout = entry.second.DefaultCastAs(LogicalType::INTEGER).GetValue<int32_t>();
+        } else if (option == "isolation") {
+            isolation = OdbcParameterParser::ParseIsolationLevel(entry.second.ToString());
+        } else if (option == "all_varchar") {
+            options.all_varchar = BooleanValue::Get(entry.second.DefaultCastAs(LogicalType::BOOLEAN));
+        } else if (option == "encoding") {
+            options.encoding = entry.second.ToString();
+            OdbcEncoding::VerifyEncoding(options.encoding);
+        } else if (option == "filter_pushdown") {
+            options.filter_pushdown = BooleanValue::Get(entry.second.DefaultCastAs(LogicalType::BOOLEAN));
+        } else if (option == "batch_size") {
+            auto batch_size = entry.second.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+            if (batch_size <= 0) {
+                throw BinderException("Option 'batch_size' must be greater than zero");
+            }
+            options.batch_size = static_cast<idx_t>(batch_size);
+            options.adaptive_batch_size = false;
+        } else if (option == "max_lob_size") {
+            auto max_lob_size = entry.second.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+            if (max_lob_size < 0) {
+                throw BinderException("Option 'max_lob_size' must not be negative");
+            }
+            options.max_lob_size = static_cast<idx_t>(max_lob_size);
+        } else if (option == "query_timeout") {
+            auto seconds = entry.second.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+            if (seconds < 0) {
+                throw BinderException("Option 'query_timeout' must not be negative");
+            }
+            options.query_timeout = static_cast<idx_t>(seconds);
+        } else if (option == "fetch_timeout") {
+            auto seconds = entry.second.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+            if (seconds < 0) {
+                throw BinderException("Option 'fetch_timeout' must not be negative");
+            }
+            options.fetch_timeout = static_cast<idx_t>(seconds);
+        } else if (option == "cache") {
+            options.cache = BooleanValue::Get(entry.second.DefaultCastAs(LogicalType::BOOLEAN));
+        } else if (option == "lob_overflow") {
+            options.lob_overflow_null = OdbcParameterParser::ParseLobOverflow(entry.second.ToString());
+        } else if (option == "schema_query") {
+            schema_query = entry.second.ToString();
+            has_schema_query = true;
+        } else {
+            throw BinderException("Unrecognized option for ODBC attach: %s", entry.first);
+        }
+    }
+
+    // Tables are only read, so the session can be read-only and share the pool with odbc_scan
+    ConnectionParams params(info.path, username, password, timeout, true, isolation);
+
+    // Connect once to fail early on a bad data source and to learn its dialect and default schema
+    // (connection errors are reported by Acquire)
+    std::string dbms_name;
+    std::string default_schema;
+    auto connection = OdbcConnectionPool::Acquire(context, params);
+    try {
+        dbms_name = connection->GetNativeConnection().dbms_name();
+    } catch (const nanodbc::database_error &) {
+        // Unknown DBMS - dialect specific pushdown stays off
+    }
+    auto query = has_schema_query ? schema_query : OdbcDialect::CurrentSchemaQuery(dbms_name);
+    if (!query.empty()) {
+        // Driver errors arrive converted by OdbcStatement
+        try {
+            auto stmt = connection->Prepare(query);
+            if (stmt->Step() && !stmt->IsNull(0)) {
+                default_schema = stmt->GetString(0);
+            }
+        } catch (const Exception &) {
+            // Unqualified names are then looked up in all schemas
+            default_schema.clear();
+        }
+    }
+    connection.reset();
+
+    auto pool = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcConnectionPool>(OdbcConnectionPool::ObjectType());
+    return make_uniq<OdbcCatalog>(db, std::move(params), std::move(options), std::move(pool), std::move(dbms_name),
+                                  std::move(default_schema));
+}
+
+static unique_ptr<TransactionManager> OdbcCreateTransactionManager(StorageExtensionInfo *storage_info,
+                                                                   AttachedDatabase &db, Catalog &catalog) {
+    return make_uniq<OdbcTransactionManager>(db);
+}
+
+OdbcStorageExtension::OdbcStorageExtension() {
+    attach = OdbcAttach;
+    create_transaction_manager = OdbcCreateTransactionManager;
+}
+
+} // namespace duckdb
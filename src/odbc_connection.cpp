@@ -1,6 +1,11 @@
 #include "odbc_connection.hpp"
+#include "odbc_driver_info.hpp"
 #include "odbc_statement.hpp"
 #include "odbc_utils.hpp"
+#include "odbc_cancel.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_rowset.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/parser/column_list.hpp"
 #include "duckdb/parser/constraints/not_null_constraint.hpp"
 #include "duckdb/parser/constraints/unique_constraint.hpp"
@@ -15,11 +20,13 @@ ConnectionParams::ConnectionParams(std::string connection_info,
                                  std::string username,
                                  std::string password,
                                  int timeout,
-                                 bool read_only)
+                                 bool read_only,
+                                 SQLUINTEGER isolation)
     : username(std::move(username))
     , password(std::move(password))
     , timeout(timeout)
-    , read_only(read_only) {
+    , read_only(read_only)
+    , isolation(isolation) {
     
     // Determine if this is a DSN or connection string
     if (connection_info.find('=') == std::string::npos) {
@@ -47,11 +54,22 @@ std::string ConnectionParams::GetConnectionString() const {
     return std::string();
 }
 
+std::string ConnectionParams::GetKey() const {
+    // Unit separators keep the fields from running into each other
+    return dsn + '\x1f' + connection_string + '\x1f' + username + '\x1f' + password + '\x1f' +
+           std::to_string(timeout) + '\x1f' + (read_only ? "ro" : "rw") + '\x1f' + std::to_string(isolation);
+}
+
+std::string ConnectionParams::GetDataSourceKey() const {
+    return dsn + '\x1f' + connection_string + '\x1f' + username;
+}
+
 //---------------------------------------------------------------------------
 // OdbcConnection implementation
 //---------------------------------------------------------------------------
 
 OdbcConnection::~OdbcConnection() {
+    ClearStatementCache();
     // Close connection if open
     if (IsOpen()) {
         try {
@@ -64,11 +82,14 @@ OdbcConnection::~OdbcConnection() {
 
 OdbcConnection::OdbcConnection(OdbcConnection &&other) noexcept {
     connection = std::move(other.connection);
+    statement_cache = std::move(other.statement_cache);
+    driver_info = std::move(other.driver_info);
 }
 
 OdbcConnection &OdbcConnection::operator=(OdbcConnection &&other) noexcept {
     if (this != &other) {
         // Close current connection if open
+        ClearStatementCache();
         if (IsOpen()) {
             try {
                 connection.disconnect();
@@ -79,6 +100,8 @@ OdbcConnection &OdbcConnection::operator=(OdbcConnection &&other) noexcept {
         
         // Move the connection
         connection = std::move(other.connection);
+        statement_cache = std::move(other.statement_cache);
+        driver_info = std::move(other.driver_info);
     }
     return *this;
 }
@@ -115,6 +138,17 @@ unique_ptr<OdbcConnection> OdbcConnection::Connect(const ConnectionParams& param
             }
         }
         
+        // Unlike read-only mode, a requested isolation level is part of the result's
+        // semantics, so a driver that rejects it fails the connection
+        if (params.GetIsolation() != 0) {
+            SQLHDBC nativeHandle = db->connection.native_dbc_handle();
+            SQLRETURN rc = SQLSetConnectAttr(nativeHandle, SQL_ATTR_TXN_ISOLATION,
+                                             (SQLPOINTER)(uintptr_t)params.GetIsolation(), 0);
+            if (!SQL_SUCCEEDED(rc)) {
+                throw BinderException("The ODBC driver does not support the requested isolation level");
+            }
+        }
+        
         return db;
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException(params.GetDsn().empty() ? 
@@ -137,11 +171,63 @@ unique_ptr<OdbcStatement> OdbcConnection::Prepare(const std::string &query) {
     }
 }
 
-void OdbcConnection::Execute(const std::string &query) {
+unique_ptr<OdbcStatement> OdbcConnection::PrepareCached(const std::string &query) {
+    for (auto it = statement_cache.begin(); it != statement_cache.end(); ++it) {
+        if ((*it)->GetQuery() == query) {
+            auto statement = std::move(*it);
+            statement_cache.erase(it);
+            return statement;
+        }
+    }
+    return Prepare(query);
+}
+
+void OdbcConnection::ReleaseStatement(unique_ptr<OdbcStatement> statement) {
+    if (!statement || !IsOpen()) {
+        return;
+    }
+    try {
+        if (!statement->Recycle()) {
+            return;
+        }
+    } catch (...) {
+        // Broken statement - it is closed when it goes out of scope
+        return;
+    }
+    statement_cache.push_front(std::move(statement));
+    if (statement_cache.size() > STATEMENT_CACHE_SIZE) {
+        statement_cache.pop_back();
+    }
+}
+
+void OdbcConnection::ClearStatementCache() {
+    statement_cache.clear();
+}
+
+int64_t OdbcConnection::Execute(const std::string &query, idx_t query_timeout) {
+    try {
+        // SQLRowCount of the statement
+        return nanodbc::execute(connection, query, 1, static_cast<long>(query_timeout)).affected_rows();
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("execute query \"" + query + "\"", e);
+        return -1; // Won't reach here due to exception
+    }
+}
+
+int64_t OdbcConnection::Execute(ClientContext &context, const std::string &query, idx_t query_timeout) {
     try {
-        nanodbc::just_execute(connection, query);
+        nanodbc::statement statement(connection);
+        OdbcCancelGuard cancel(context, static_cast<SQLHSTMT>(statement.native_statement_handle()), query_timeout,
+                               "query_timeout");
+        try {
+            return statement.execute_direct(connection, query, 1, static_cast<long>(query_timeout)).affected_rows();
+        } catch (...) {
+            cancel.ThrowIfCancelled();
+            throw;
+        }
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("execute query \"" + query + "\"", e);
+        return -1; // Won't reach here due to exception
     }
 }
 
@@ -149,114 +235,181 @@ bool OdbcConnection::IsOpen() const {
     return connection.connected();
 }
 
-std::vector<std::string> OdbcConnection::GetTables() {
-    std::vector<std::string> tables;
+bool OdbcConnection::IsHealthy() {
+    if (!IsOpen()) {
+        return false;
+    }
     
+    // SQL_ATTR_CONNECTION_DEAD is answered from the driver's state without a round trip.
+    // Drivers that do not implement it are assumed healthy.
+    SQLUINTEGER dead = SQL_CD_FALSE;
+    SQLRETURN rc = SQLGetConnectAttr(connection.native_dbc_handle(), SQL_ATTR_CONNECTION_DEAD, &dead, 0, nullptr);
+    return !SQL_SUCCEEDED(rc) || dead != SQL_CD_TRUE;
+}
+
+const OdbcDriverInfo &OdbcConnection::GetDriverInfo() const {
+    static const OdbcDriverInfo conservative;
+    return driver_info ? *driver_info : conservative;
+}
+
+void OdbcConnection::SetDriverInfo(std::shared_ptr<const OdbcDriverInfo> info) {
+    driver_info = std::move(info);
+}
+
+void OdbcConnection::GetTablesAndViews(std::vector<std::string> &tables, std::vector<std::string> &views) {
     try {
-        // Use nanodbc's catalog functions to get tables
+        // One SQLTables call for all types (the type argument is a comma-separated list)
         nanodbc::catalog catalog(connection);
-        auto tableResults = catalog.find_tables(std::string(), std::string("TABLE"), std::string(), std::string());
+        auto results = catalog.find_tables(std::string(), std::string("TABLE,VIEW,SYSTEM VIEW"), std::string(),
+                                           std::string());
         
-        while (tableResults.next()) {
-            std::string tableName = tableResults.table_name();
-            tables.push_back(tableName);
+        while (results.next()) {
+            std::string name = results.table_name();
+            std::string type = results.table_type();
+            if (StringUtil::CIEquals(type, "TABLE")) {
+                tables.push_back(name);
+            } else {
+                views.push_back(name);
+            }
         }
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("get table list", e);
     }
-    
-    return tables;
 }
 
-void OdbcConnection::GetTableInfo(const std::string &tableName, ColumnList &columns, 
-                                std::vector<std::unique_ptr<Constraint>> &constraints, bool allVarchar) {
+std::string OdbcConnection::GetPrimaryKeyColumn(const std::string &tableName) {
+    std::vector<std::string> keyColumns;
+    
     try {
-        // Get column information using nanodbc catalog
         nanodbc::catalog catalog(connection);
-        auto columnResults = catalog.find_columns(std::string(), tableName, std::string(), std::string());
+        auto keyResults = catalog.find_primary_keys(tableName);
+        
+        while (keyResults.next()) {
+            keyColumns.push_back(keyResults.column_name());
+        }
+    } catch (const nanodbc::database_error& e) {
+        // Not every driver implements SQLPrimaryKeys - treat it as "no key"
+        return std::string();
+    }
+    
+    return keyColumns.size() == 1 ? keyColumns[0] : std::string();
+}
 
-        idx_t columnIndex = 0;
+std::vector<OdbcTableInfo> OdbcConnection::GetColumns(const std::string &schemaName, const std::string &tablePattern,
+                                                      bool allVarchar) {
+    std::vector<OdbcTableInfo> tables;
+    
+    // Get column information using nanodbc catalog
+    nanodbc::catalog catalog(connection);
+    auto columnResults = catalog.find_columns(std::string(), tablePattern, schemaName, std::string());
+    
+    while (columnResults.next()) {
+        std::string schema = columnResults.table_schema();
+        std::string table = columnResults.table_name();
+        if (tables.empty() || tables.back().name != table || tables.back().schema != schema) {
+            OdbcTableInfo info;
+            info.schema = schema;
+            info.name = table;
+            tables.push_back(std::move(info));
+        }
         
-        while (columnResults.next()) {
-            std::string name = columnResults.column_name();
-            SQLSMALLINT dataType = columnResults.data_type();
-            SQLULEN columnSize = 0;
-            // Get column size safely - catch exceptions for VARCHAR types
-            try {
-                columnSize = columnResults.column_size();
-            } catch (const std::exception& e) {
-                // If column_size() fails, use a safe default (for VARCHAR in DuckDB)
-                columnSize = 0; // Will be handled when converting to logical type
-            }
-            SQLSMALLINT decimalDigits = columnResults.decimal_digits();
-            SQLSMALLINT nullable = columnResults.nullable();
-            
-            LogicalType columnType;
-            if (allVarchar) {
-                columnType = LogicalType::VARCHAR;
-            } else {
-                // For VARCHAR types in DuckDB, don't rely on column size
-                if (OdbcUtils::IsVarcharType(dataType)) {
-                    columnType = LogicalType::VARCHAR;
-                } else {
-                    columnType = OdbcUtils::OdbcTypeToLogicalType(dataType, columnSize, decimalDigits);
-                }
-            }
-            
-            ColumnDefinition column(std::move(name), columnType);
-            columns.AddColumn(std::move(column));
-            
-            if (nullable == SQL_NO_NULLS) {
-                constraints.push_back(make_uniq<NotNullConstraint>(LogicalIndex(columnIndex)));
-            }
-            
-            columnIndex++;
+        OdbcColumnInfo column;
+        column.name = columnResults.column_name();
+        SQLSMALLINT dataType = columnResults.data_type();
+        SQLULEN columnSize = 0;
+        // Get column size safely - catch exceptions for VARCHAR types
+        try {
+            columnSize = columnResults.column_size();
+        } catch (const std::exception& e) {
+            // If column_size() fails, use a safe default (for VARCHAR in DuckDB)
+            columnSize = 0; // Will be handled when converting to logical type
         }
+        SQLSMALLINT decimalDigits = columnResults.decimal_digits();
+        column.not_null = columnResults.nullable() == SQL_NO_NULLS;
         
-        if (columnIndex == 0) {
-            throw BinderException("No columns found for table '" + tableName + "'");
+        if (allVarchar) {
+            column.type = LogicalType::VARCHAR;
+        } else if (OdbcUtils::IsVarcharType(dataType)) {
+            // For VARCHAR types in DuckDB, don't rely on column size
+            column.type = LogicalType::VARCHAR;
+        } else {
+            column.type = OdbcUtils::OdbcTypeToLogicalType(dataType, columnSize, decimalDigits);
         }
-
-    } catch (const nanodbc::database_error& e) {
-        OdbcUtils::ThrowException("get table info for '" + tableName + "'", e);
+        tables.back().columns.push_back(std::move(column));
     }
+    
+    return tables;
 }
 
-std::vector<std::string> OdbcConnection::GetViews() {
-    std::vector<std::string> views;
+optional_idx OdbcConnection::GetTableCardinality(const std::string &schemaName, const std::string &tableName) {
+    // nanodbc has no SQLStatistics wrapper, so this runs on a raw statement handle
+    SQLHSTMT stmt = SQL_NULL_HSTMT;
+    if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, connection.native_dbc_handle(), &stmt))) {
+        return optional_idx();
+    }
+    
+    // Names are passed as wide characters, like nanodbc's catalog calls do in a Unicode build
+    optional_idx cardinality;
+    std::vector<odbc_wide_unit_t> schema, table;
+    OdbcEncoding::StringToWide(schemaName, schema);
+    OdbcEncoding::StringToWide(tableName, table);
+    auto schema_name = reinterpret_cast<SQLWCHAR *>(schema.data());
+    auto table_name = reinterpret_cast<SQLWCHAR *>(table.data());
+    SQLRETURN ret = SQLStatisticsW(stmt, nullptr, 0, schemaName.empty() ? nullptr : schema_name,
+                                   schemaName.empty() ? 0 : SQL_NTS, table_name, SQL_NTS, SQL_INDEX_ALL, SQL_QUICK);
+    if (SQL_SUCCEEDED(ret)) {
+        // The table statistics row, if any, comes before the index rows
+        while (SQL_SUCCEEDED(SQLFetch(stmt))) {
+            SQLSMALLINT type = 0;
+            SQLLEN indicator = 0;
+            ret = SQLGetData(stmt, 7, SQL_C_SSHORT, &type, 0, &indicator);
+            if (!SQL_SUCCEEDED(ret) || indicator == SQL_NULL_DATA || type != SQL_TABLE_STAT) {
+                continue;
+            }
+            SQLBIGINT rows = 0;
+            ret = SQLGetData(stmt, 11, SQL_C_SBIGINT, &rows, 0, &indicator);
+            if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA && rows >= 0) {
+                cardinality = optional_idx(static_cast<idx_t>(rows));
+            }
+            break;
+        }
+    }
     
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    return cardinality;
+}
+
+void OdbcConnection::GetTableInfo(const std::string &tableName, ColumnList &columns, 
+                                std::vector<std::unique_ptr<Constraint>> &constraints, bool allVarchar) {
     try {
-        // Use nanodbc's catalog functions to get views
-        nanodbc::catalog catalog(connection);
-        
-        // VIEW type for standard ODBC
-        auto viewResults = catalog.find_tables(std::string(), std::string("VIEW"), std::string(), std::string());
+        // The table name is a search pattern ('_' matches any character), so take
+        // the first table whose name actually matches
+        auto tables = GetColumns(std::string(), tableName, allVarchar);
+        const OdbcTableInfo *table = nullptr;
+        for (auto &candidate : tables) {
+            if (StringUtil::CIEquals(candidate.name, tableName)) {
+                table = &candidate;
+                break;
+            }
+        }
         
-        while (viewResults.next()) {
-            std::string viewName = viewResults.table_name();
-            views.push_back(viewName);
+        if (!table || table->columns.empty()) {
+            throw BinderException("No columns found for table '" + tableName + "'");
         }
         
-        // Some databases might use different types for views
-        try {
-            // Try for databases that use "SYSTEM VIEW" type
-            auto sysViewResults = catalog.find_tables(std::string(), std::string("SYSTEM VIEW"), std::string(), std::string());
+        for (idx_t columnIndex = 0; columnIndex < table->columns.size(); columnIndex++) {
+            auto &info = table->columns[columnIndex];
+            ColumnDefinition column(info.name, info.type);
+            columns.AddColumn(std::move(column));
             
-            while (sysViewResults.next()) {
-                std::string viewName = sysViewResults.table_name();
-                views.push_back(viewName);
+            if (info.not_null) {
+                constraints.push_back(make_uniq<NotNullConstraint>(LogicalIndex(columnIndex)));
             }
-        } catch (...) {
-            // Ignore if this fails - just continue with the views we've found
         }
-        
+
     } catch (const nanodbc::database_error& e) {
-        // Just log the error rather than failing completely
-        // This allows partial attachment to work
-        fprintf(stderr, "Warning: Could not get views: %s\n", e.what());
+        OdbcUtils::ThrowException("get table info for '" + tableName + "'", e);
     }
-    
-    return views;
 }
 
 } // namespace duckdb
\ No newline at end of file
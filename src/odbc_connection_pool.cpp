@@ -0,0 +1,198 @@
+#include "odbc_connection_pool.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+namespace duckdb {
+
+static idx_t GetPoolSetting(ClientContext &context, const std::string &name, idx_t default_value) {
+    Value value;
+    if (context.TryGetCurrentSetting(name, value) && !value.IsNull()) {
+        return value.GetValue<uint64_t>();
+    }
+    return default_value;
+}
+
+std::shared_ptr<OdbcConnectionPool> OdbcConnectionPool::Get(ClientContext &context) {
+    auto pool = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcConnectionPool>(ObjectType());
+    pool->SetLimits(GetPoolSetting(context, "odbc_pool_size", DEFAULT_POOL_SIZE),
+                    GetPoolSetting(context, "odbc_pool_idle_timeout", DEFAULT_IDLE_TIMEOUT_SECONDS));
+    return pool;
+}
+
+std::shared_ptr<OdbcConnection> OdbcConnectionPool::Acquire(ClientContext &context, const ConnectionParams &params) {
+    return Get(context)->AcquireConnection(params);
+}
+
+void OdbcConnectionPool::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_pool_size", 
+                              "Maximum number of idle ODBC connections kept per data source (0 disables pooling)",
+                              LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_POOL_SIZE));
+    config.AddExtensionOption("odbc_pool_idle_timeout", 
+                              "Seconds an idle pooled ODBC connection is kept before it is closed",
+                              LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_IDLE_TIMEOUT_SECONDS));
+}
+
+std::shared_ptr<OdbcConnection> OdbcConnectionPool::AcquireConnection(const ConnectionParams &params) {
+    auto key = params.GetKey();
+    
+    // Health checks talk to the driver, so they run outside the lock
+    unique_ptr<OdbcConnection> connection;
+    while (!connection) {
+        auto candidate = TakeIdle(key);
+        if (!candidate) {
+            connection = OdbcConnection::Connect(params);
+            break;
+        }
+        if (candidate->IsHealthy()) {
+            connection = std::move(candidate);
+        }
+    }
+    AttachDriverInfo(params, *connection);
+    
+    auto pool = shared_from_this();
+    return std::shared_ptr<OdbcConnection>(connection.release(), [pool, key](OdbcConnection *released) {
+        pool->Release(key, unique_ptr<OdbcConnection>(released));
+    });
+}
+
+void OdbcConnectionPool::SetLimits(idx_t max_idle_p, idx_t idle_timeout_seconds_p) {
+    vector<unique_ptr<OdbcConnection>> expired;
+    {
+        lock_guard<mutex> guard(lock);
+        max_idle = max_idle_p;
+        idle_timeout_seconds = idle_timeout_seconds_p;
+        for (auto &entry : idle) {
+            while (entry.second.size() > max_idle) {
+                expired.push_back(std::move(entry.second.front().connection));
+                entry.second.pop_front();
+            }
+        }
+        CollectExpired(expired);
+    }
+    // Connections are closed when expired goes out of scope, after the lock is released
+}
+
+void OdbcConnectionPool::Clear() {
+    std::unordered_map<std::string, std::deque<IdleConnection>> closing;
+    {
+        lock_guard<mutex> guard(lock);
+        closing.swap(idle);
+    }
+}
+
+void OdbcConnectionPool::AttachDriverInfo(const ConnectionParams &params, OdbcConnection &connection) {
+    auto key = params.GetDataSourceKey();
+    {
+        lock_guard<mutex> guard(lock);
+        auto &profile = drivers[key];
+        if (profile.effective) {
+            connection.SetDriverInfo(profile.effective);
+            return;
+        }
+    }
+    
+    // Probing talks to the driver, so it runs outside the lock; a concurrent first
+    // connection may probe as well, the first result is kept
+    auto handle = connection.GetNativeConnection().native_dbc_handle();
+    auto detected = std::make_shared<const OdbcDriverInfo>(OdbcDriverInfo::Probe(handle));
+    lock_guard<mutex> guard(lock);
+    auto &profile = drivers[key];
+    if (!profile.detected) {
+        profile.detected = std::move(detected);
+        UpdateEffective(profile);
+    }
+    connection.SetDriverInfo(profile.effective);
+}
+
+void OdbcConnectionPool::UpdateEffective(DriverProfile &profile) {
+    if (!profile.detected) {
+        return;
+    }
+    auto effective = std::make_shared<OdbcDriverInfo>(*profile.detected);
+    for (auto &entry : profile.overrides) {
+        effective->Set(entry.first, entry.second);
+    }
+    profile.effective = std::move(effective);
+}
+
+std::shared_ptr<const OdbcDriverInfo> OdbcConnectionPool::GetDetectedDriverInfo(const ConnectionParams &params) {
+    lock_guard<mutex> guard(lock);
+    auto entry = drivers.find(params.GetDataSourceKey());
+    return entry == drivers.end() ? nullptr : entry->second.detected;
+}
+
+std::shared_ptr<const OdbcDriverInfo> OdbcConnectionPool::GetDriverInfo(const ConnectionParams &params) {
+    lock_guard<mutex> guard(lock);
+    auto entry = drivers.find(params.GetDataSourceKey());
+    return entry == drivers.end() ? nullptr : entry->second.effective;
+}
+
+void OdbcConnectionPool::OverrideDriverInfo(const ConnectionParams &params,
+                                            const vector<std::pair<std::string, Value>> &overrides, bool reset) {
+    // Validate before anything is stored
+    OdbcDriverInfo check;
+    for (auto &entry : overrides) {
+        check.Set(entry.first, entry.second);
+    }
+    
+    lock_guard<mutex> guard(lock);
+    auto &profile = drivers[params.GetDataSourceKey()];
+    if (reset) {
+        profile.overrides.clear();
+    }
+    for (auto &entry : overrides) {
+        profile.overrides.push_back(entry);
+    }
+    UpdateEffective(profile);
+}
+
+unique_ptr<OdbcConnection> OdbcConnectionPool::TakeIdle(const std::string &key) {
+    vector<unique_ptr<OdbcConnection>> expired;
+    lock_guard<mutex> guard(lock);
+    CollectExpired(expired);
+    
+    auto entry = idle.find(key);
+    if (entry == idle.end() || entry->second.empty()) {
+        return nullptr;
+    }
+    auto connection = std::move(entry->second.back().connection);
+    entry->second.pop_back();
+    return connection;
+}
+
+void OdbcConnectionPool::Release(const std::string &key, unique_ptr<OdbcConnection> connection) {
+    try {
+        if (!connection || !connection->IsHealthy()) {
+            return;
+        }
+        
+        lock_guard<mutex> guard(lock);
+        auto &connections = idle[key];
+        if (connections.size() >= max_idle) {
+            // Pool is full - the connection is closed on return
+            return;
+        }
+        connections.push_back(IdleConnection {std::move(connection), std::chrono::steady_clock::now()});
+    } catch (...) {
+        // Called from a shared_ptr deleter - never throw
+    }
+}
+
+void OdbcConnectionPool::CollectExpired(vector<unique_ptr<OdbcConnection>> &expired) {
+    auto cutoff = std::chrono::steady_clock::now() - std::chrono::seconds(idle_timeout_seconds);
+    for (auto entry = idle.begin(); entry != idle.end();) {
+        auto &connections = entry->second;
+        // Connections are appended on release, so the oldest ones are at the front
+        while (!connections.empty() && connections.front().released < cutoff) {
+            expired.push_back(std::move(connections.front().connection));
+            connections.pop_front();
+        }
+        if (connections.empty()) {
+            entry = idle.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+} // namespace duckdb
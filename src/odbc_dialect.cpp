@@ -0,0 +1,126 @@
+#include "odbc_dialect.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+OdbcLimitSyntax OdbcDialect::GetLimitSyntax(const std::string &dbms_name) {
+    auto name = StringUtil::Lower(dbms_name);
+    auto contains = [&](const char *needle) { return name.find(needle) != std::string::npos; };
+    
+    if (contains("sql server") || contains("access") || contains("sybase") || contains("adaptive server")) {
+        return OdbcLimitSyntax::TOP;
+    }
+    if (contains("oracle")) {
+        return OdbcLimitSyntax::ROWNUM;
+    }
+    if (StringUtil::StartsWith(name, "db2") || contains("derby")) {
+        return OdbcLimitSyntax::FETCH_FIRST;
+    }
+    if (contains("postgres") || contains("mysql") || contains("mariadb") || contains("sqlite") ||
+        contains("duckdb") || contains("snowflake") || contains("redshift") || contains("vertica") ||
+        contains("clickhouse")) {
+        return OdbcLimitSyntax::LIMIT;
+    }
+    return OdbcLimitSyntax::NONE;
+}
+
+std::string OdbcDialect::LimitQuery(OdbcLimitSyntax syntax, const std::string &select_list,
+                                    const std::string &table_expression, const std::string &order_by, idx_t limit) {
+    auto order_clause = order_by.empty() ? std::string() : " ORDER BY " + order_by;
+    auto count = std::to_string(limit);
+    
+    switch (syntax) {
+        case OdbcLimitSyntax::LIMIT:
+            return "SELECT " + select_list + " " + table_expression + order_clause + " LIMIT " + count;
+        case OdbcLimitSyntax::TOP:
+            return "SELECT TOP " + count + " " + select_list + " " + table_expression + order_clause;
+        case OdbcLimitSyntax::FETCH_FIRST:
+            return "SELECT " + select_list + " " + table_expression + order_clause + " FETCH FIRST " + count +
+                   " ROWS ONLY";
+        case OdbcLimitSyntax::ROWNUM:
+            // ROWNUM is assigned before ORDER BY, so the ordered query has to be nested
+            return "SELECT * FROM (SELECT " + select_list + " " + table_expression + order_clause + 
+                   ") WHERE ROWNUM <= " + count;
+        default:
+            return "SELECT " + select_list + " " + table_expression + order_clause;
+    }
+}
+
+std::string OdbcDialect::CountFunction(const std::string &dbms_name) {
+    auto name = StringUtil::Lower(dbms_name);
+    auto contains = [&](const char *needle) { return name.find(needle) != std::string::npos; };
+    
+    if (contains("sql server") || contains("sybase") || contains("adaptive server")) {
+        return "COUNT_BIG";
+    }
+    return "COUNT";
+}
+
+std::string OdbcDialect::RowCountQuery(const std::string &dbms_name, const std::string &schema_name,
+                                       const std::string &table_name) {
+    auto name = StringUtil::Lower(dbms_name);
+    auto contains = [&](const char *needle) { return name.find(needle) != std::string::npos; };
+    auto literal = [](const std::string &value) { return "'" + StringUtil::Replace(value, "'", "''") + "'"; };
+    auto quoted = [](const std::string &value) { return "\"" + StringUtil::Replace(value, "\"", "\"\"") + "\""; };
+    auto qualified = schema_name.empty() ? quoted(table_name) : quoted(schema_name) + "." + quoted(table_name);
+    
+    if (contains("postgres") || contains("redshift")) {
+        // reltuples is -1 for tables that were never analyzed
+        return "SELECT reltuples FROM pg_class WHERE oid = to_regclass(" + literal(qualified) + ")";
+    }
+    if (contains("sql server")) {
+        return "SELECT SUM(rows) FROM sys.partitions WHERE index_id IN (0, 1) AND object_id = OBJECT_ID(" +
+               literal(qualified) + ")";
+    }
+    if (contains("mysql") || contains("mariadb")) {
+        return "SELECT TABLE_ROWS FROM information_schema.TABLES WHERE TABLE_NAME = " + literal(table_name) +
+               " AND TABLE_SCHEMA = " + (schema_name.empty() ? "DATABASE()" : literal(schema_name));
+    }
+    if (contains("oracle")) {
+        return "SELECT NUM_ROWS FROM ALL_TABLES WHERE TABLE_NAME = " + literal(table_name) + " AND OWNER = " +
+               (schema_name.empty() ? "USER" : literal(schema_name));
+    }
+    if (contains("duckdb")) {
+        return "SELECT estimated_size FROM duckdb_tables() WHERE table_name = " + literal(table_name) +
+               " AND schema_name = " + (schema_name.empty() ? "current_schema()" : literal(schema_name));
+    }
+    return std::string();
+}
+
+std::string OdbcDialect::CurrentSchemaQuery(const std::string &dbms_name) {
+    auto name = StringUtil::Lower(dbms_name);
+    auto contains = [&](const char *needle) { return name.find(needle) != std::string::npos; };
+    
+    if (contains("postgres") || contains("redshift") || contains("duckdb") || contains("snowflake") ||
+        contains("vertica")) {
+        return "SELECT current_schema()";
+    }
+    if (contains("sql server")) {
+        return "SELECT SCHEMA_NAME()";
+    }
+    if (contains("oracle")) {
+        return "SELECT SYS_CONTEXT('USERENV', 'CURRENT_SCHEMA') FROM DUAL";
+    }
+    if (StringUtil::StartsWith(name, "db2")) {
+        return "SELECT CURRENT SCHEMA FROM SYSIBM.SYSDUMMY1";
+    }
+    return std::string();
+}
+
+std::string OdbcDialect::ExportSnapshotQuery(const std::string &dbms_name) {
+    // Redshift reports itself as PostgreSQL but has no snapshot export
+    auto name = StringUtil::Lower(dbms_name);
+    if (name.find("postgres") != std::string::npos && name.find("redshift") == std::string::npos) {
+        return "SELECT pg_export_snapshot()";
+    }
+    return std::string();
+}
+
+std::vector<std::string> OdbcDialect::ImportSnapshotStatements(const std::string &dbms_name,
+                                                               const std::string &snapshot_id) {
+    // Only REPEATABLE READ and SERIALIZABLE transactions can import a snapshot
+    return {"SET TRANSACTION ISOLATION LEVEL REPEATABLE READ",
+            "SET TRANSACTION SNAPSHOT '" + StringUtil::Replace(snapshot_id, "'", "''") + "'"};
+}
+
+} // namespace duckdb
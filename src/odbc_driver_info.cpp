@@ -0,0 +1,236 @@
+#include "odbc_driver_info.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_parameters.hpp"
+#include "odbc_rowset.hpp"
+#include "odbc_utils.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Probing
+//------------------------------------------------------------------------------
+
+static std::string GetInfoString(SQLHDBC dbc, SQLUSMALLINT type) {
+    char buffer[256];
+    SQLSMALLINT length = 0;
+    if (!SQL_SUCCEEDED(SQLGetInfo(dbc, type, buffer, sizeof(buffer), &length)) || length < 0) {
+        return std::string();
+    }
+    return std::string(buffer, MinValue<idx_t>(static_cast<idx_t>(length), sizeof(buffer) - 1));
+}
+
+static SQLUINTEGER GetInfoInteger(SQLHDBC dbc, SQLUSMALLINT type) {
+    SQLUINTEGER value = 0;
+    if (!SQL_SUCCEEDED(SQLGetInfo(dbc, type, &value, sizeof(value), nullptr))) {
+        return 0;
+    }
+    return value;
+}
+
+static bool HasFunction(SQLHDBC dbc, SQLUSMALLINT function) {
+    SQLUSMALLINT supported = SQL_FALSE;
+    return SQL_SUCCEEDED(SQLGetFunctions(dbc, function, &supported)) && supported == SQL_TRUE;
+}
+
+// Set a statement attribute and read back what the driver settled on (0 if it refused)
+static SQLULEN TryStatementSize(SQLHSTMT stmt, SQLINTEGER attribute, SQLULEN size) {
+    if (!SQL_SUCCEEDED(SQLSetStmtAttr(stmt, attribute, (SQLPOINTER)(uintptr_t)size, 0))) {
+        return 0;
+    }
+    SQLULEN actual = 0;
+    if (!SQL_SUCCEEDED(SQLGetStmtAttr(stmt, attribute, &actual, 0, nullptr))) {
+        return size;
+    }
+    return actual;
+}
+
+OdbcDriverInfo OdbcDriverInfo::Probe(SQLHDBC dbc) {
+    OdbcDriverInfo info;
+    info.dbms_name = GetInfoString(dbc, SQL_DBMS_NAME);
+    info.dbms_version = GetInfoString(dbc, SQL_DBMS_VER);
+    info.driver_name = GetInfoString(dbc, SQL_DRIVER_NAME);
+    info.driver_version = GetInfoString(dbc, SQL_DRIVER_VER);
+    info.driver_odbc_version = GetInfoString(dbc, SQL_DRIVER_ODBC_VER);
+
+    switch (GetInfoInteger(dbc, SQL_ASYNC_MODE)) {
+        case SQL_AM_CONNECTION:
+            info.async_mode = "connection";
+            break;
+        case SQL_AM_STATEMENT:
+            info.async_mode = "statement";
+            break;
+        default:
+            info.async_mode = "none";
+            break;
+    }
+
+    auto getdata = GetInfoInteger(dbc, SQL_GETDATA_EXTENSIONS);
+    info.getdata_any_column = (getdata & SQL_GD_ANY_COLUMN) != 0;
+    info.getdata_any_order = (getdata & SQL_GD_ANY_ORDER) != 0;
+    info.getdata_bound = (getdata & SQL_GD_BOUND) != 0;
+    // Rows of a block cursor are selected with SQLSetPos before SQLGetData
+    info.getdata_block = (getdata & SQL_GD_BLOCK) != 0 && HasFunction(dbc, SQL_API_SQLSETPOS);
+
+    // The statement attributes are checked on a scratch statement; setting them does not
+    // talk to the data source
+    SQLHSTMT stmt = SQL_NULL_HSTMT;
+    if (SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, dbc, &stmt))) {
+        auto rowset_size = TryStatementSize(stmt, SQL_ATTR_ROW_ARRAY_SIZE, OdbcRowset::MAX_ADAPTIVE_ROWSET_SIZE);
+        info.max_rowset_size = MaxValue<idx_t>(rowset_size, 1);
+        info.block_cursors = rowset_size > 1 && HasFunction(dbc, SQL_API_SQLFETCHSCROLL);
+        info.param_arrays = TryStatementSize(stmt, SQL_ATTR_PARAMSET_SIZE, 2) == 2;
+        SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Overrides
+//------------------------------------------------------------------------------
+
+const vector<std::string> &OdbcDriverInfo::OverridableNames() {
+    static const vector<std::string> names {"block_cursors", "max_rowset_size", "getdata_any_column",
+                                            "getdata_any_order", "getdata_block", "getdata_bound", "param_arrays"};
+    return names;
+}
+
+void OdbcDriverInfo::Set(const std::string &name, const Value &value) {
+    if (name == "max_rowset_size") {
+        auto size = value.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+        if (size < 1) {
+            throw BinderException("Driver capability 'max_rowset_size' must be at least 1");
+        }
+        max_rowset_size = static_cast<idx_t>(size);
+        return;
+    }
+
+    bool *field = nullptr;
+    if (name == "block_cursors") {
+        field = &block_cursors;
+    } else if (name == "getdata_any_column") {
+        field = &getdata_any_column;
+    } else if (name == "getdata_any_order") {
+        field = &getdata_any_order;
+    } else if (name == "getdata_block") {
+        field = &getdata_block;
+    } else if (name == "getdata_bound") {
+        field = &getdata_bound;
+    } else if (name == "param_arrays") {
+        field = &param_arrays;
+    } else {
+        throw BinderException("Unknown driver capability '%s'", name);
+    }
+    *field = BooleanValue::Get(value.DefaultCastAs(LogicalType::BOOLEAN));
+}
+
+vector<std::pair<std::string, Value>> OdbcDriverInfo::GetValues() const {
+    return {{"dbms_name", Value(dbms_name)},
+            {"dbms_version", Value(dbms_version)},
+            {"driver_name", Value(driver_name)},
+            {"driver_version", Value(driver_version)},
+            {"driver_odbc_version", Value(driver_odbc_version)},
+            {"async_mode", Value(async_mode)},
+            {"block_cursors", Value::BOOLEAN(block_cursors)},
+            {"max_rowset_size", Value::UBIGINT(max_rowset_size)},
+            {"getdata_any_column", Value::BOOLEAN(getdata_any_column)},
+            {"getdata_any_order", Value::BOOLEAN(getdata_any_order)},
+            {"getdata_block", Value::BOOLEAN(getdata_block)},
+            {"getdata_bound", Value::BOOLEAN(getdata_bound)},
+            {"param_arrays", Value::BOOLEAN(param_arrays)}};
+}
+
+//------------------------------------------------------------------------------
+// odbc_driver_info
+//------------------------------------------------------------------------------
+
+struct OdbcDriverInfoFunctionData : public TableFunctionData {
+    ConnectionParams connection_params;
+    vector<std::pair<std::string, Value>> overrides;
+    bool reset = false;
+};
+
+struct OdbcDriverInfoState : public GlobalTableFunctionState {
+    bool finished = false;
+};
+
+static unique_ptr<FunctionData> BindDriverInfo(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+    auto result = make_uniq<OdbcDriverInfoFunctionData>();
+    result->connection_params = OdbcParameterParser::ParseConnectionParams(input);
+    for (auto &name : OdbcDriverInfo::OverridableNames()) {
+        auto entry = input.named_parameters.find(name);
+        if (entry != input.named_parameters.end() && !entry->second.IsNull()) {
+            result->overrides.emplace_back(name, entry->second);
+        }
+    }
+    auto reset = input.named_parameters.find("reset");
+    result->reset = reset != input.named_parameters.end() && BooleanValue::Get(reset->second);
+
+    names = {"capability", "detected", "effective", "overridden"};
+    return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BOOLEAN};
+    return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> InitDriverInfo(ClientContext &context, TableFunctionInitInput &input) {
+    return make_uniq<OdbcDriverInfoState>();
+}
+
+static void DriverInfo(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<OdbcDriverInfoFunctionData>();
+    auto &state = data.global_state->Cast<OdbcDriverInfoState>();
+    if (state.finished) {
+        output.SetCardinality(0);
+        return;
+    }
+    state.finished = true;
+
+    // Overrides are stored first, so that they also apply if this is the first connection
+    auto pool = OdbcConnectionPool::Get(context);
+    if (!bind_data.overrides.empty() || bind_data.reset) {
+        pool->OverrideDriverInfo(bind_data.connection_params, bind_data.overrides, bind_data.reset);
+    }
+    try {
+        // Connecting probes the driver unless it is known already
+        pool->AcquireConnection(bind_data.connection_params);
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("probe driver", e);
+    }
+    auto detected = pool->GetDetectedDriverInfo(bind_data.connection_params);
+    auto effective = pool->GetDriverInfo(bind_data.connection_params);
+    if (!detected || !effective) {
+        throw InternalException("Driver capabilities missing after connecting");
+    }
+
+    auto detected_values = detected->GetValues();
+    auto effective_values = effective->GetValues();
+    idx_t count = 0;
+    for (idx_t i = 0; i < detected_values.size(); i++) {
+        auto &detected_value = detected_values[i].second;
+        auto &effective_value = effective_values[i].second;
+        output.SetValue(0, count, Value(detected_values[i].first));
+        output.SetValue(1, count, detected_value.ToString());
+        output.SetValue(2, count, effective_value.ToString());
+        output.SetValue(3, count, Value::BOOLEAN(detected_value != effective_value));
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction OdbcDriverInfoFunction() {
+    TableFunction result("odbc_driver_info", {}, DriverInfo, BindDriverInfo, InitDriverInfo);
+    result.named_parameters["connection"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["username"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["password"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["block_cursors"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["max_rowset_size"] = LogicalType(LogicalTypeId::BIGINT);
+    result.named_parameters["getdata_any_column"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["getdata_any_order"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["getdata_block"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["getdata_bound"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["param_arrays"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["reset"] = LogicalType(LogicalTypeId::BOOLEAN);
+    return result;
+}
+
+} // namespace duckdb
@@ -1,12 +1,14 @@
 #include "odbc_encoding.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "utf8proc_wrapper.hpp"
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
 #include <iconv.h>
-#include <errno.h>
 #endif
 
 namespace duckdb {
@@ -89,6 +91,26 @@ bool OdbcEncoding::NeedsConversion(const std::string& encoding) {
     return normalized != "UTF-8" && normalized != "UTF8";
 }
 
+void OdbcEncoding::VerifyEncoding(const std::string& encoding) {
+    if (!NeedsConversion(encoding)) {
+        return;
+    }
+#ifdef _WIN32
+    auto codepage = GetWindowsCodepage(encoding);
+    bool supported = codepage != 0 && IsValidCodePage(codepage);
+#else
+    auto descriptor = iconv_open("UTF-8", encoding.c_str());
+    bool supported = descriptor != (iconv_t)-1;
+    if (supported) {
+        iconv_close(descriptor);
+    }
+#endif
+    if (!supported) {
+        throw BinderException("Unsupported encoding '%s' - use a character set name such as 'WINDOWS-1252' or "
+                              "'ISO-8859-1'", encoding);
+    }
+}
+
 int OdbcEncoding::GetWindowsCodepage(const std::string& encoding) {
     std::string normalized = NormalizeEncodingName(encoding);
     
@@ -106,105 +128,321 @@ int OdbcEncoding::GetWindowsCodepage(const std::string& encoding) {
     }
 }
 
+bool OdbcEncoding::IsAscii(const char* data, idx_t length) {
+    // Check eight bytes per step
+    static constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+    idx_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= length; pos += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + pos, sizeof(uint64_t));
+        if (word & HIGH_BITS) {
+            return false;
+        }
+    }
+    for (; pos < length; pos++) {
+        if (static_cast<unsigned char>(data[pos]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void OdbcEncoding::VerifyUtf8(const char* data, idx_t length) {
+    if (IsAscii(data, length) || Utf8Proc::Analyze(data, length) != UnicodeType::INVALID) {
+        return;
+    }
+    throw InvalidInputException("Invalid UTF-8 in a character value from the ODBC data source - set the "
+                                "'encoding' parameter to the character set of the data source (e.g. "
+                                "encoding='CP1252')");
+}
+
+// ASCII fast path of the wide conversion: four UTF-16 (two UTF-32) code units per step
+template <class CHAR_T>
+static bool IsAsciiWide(const CHAR_T* data, idx_t count) {
+    static constexpr uint64_t HIGH_BITS = sizeof(CHAR_T) == 2 ? 0xFF80FF80FF80FF80ULL : 0xFFFFFF80FFFFFF80ULL;
+    static constexpr idx_t UNITS = sizeof(uint64_t) / sizeof(CHAR_T);
+    idx_t pos = 0;
+    for (; pos + UNITS <= count; pos += UNITS) {
+        uint64_t word;
+        memcpy(&word, data + pos, sizeof(uint64_t));
+        if (word & HIGH_BITS) {
+            return false;
+        }
+    }
+    for (; pos < count; pos++) {
+        if (data[pos] >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decode the code point at data[pos], advancing pos past it
+template <class CHAR_T>
+static uint32_t DecodeWide(const CHAR_T* data, idx_t count, idx_t& pos) {
+    static constexpr uint32_t REPLACEMENT = 0xFFFD;
+    uint32_t unit = data[pos++];
+    if (sizeof(CHAR_T) == 4) {
+        return unit > 0x10FFFF || (unit >= 0xD800 && unit <= 0xDFFF) ? REPLACEMENT : unit;
+    }
+    if (unit < 0xD800 || unit > 0xDFFF) {
+        return unit;
+    }
+    if (unit <= 0xDBFF && pos < count && data[pos] >= 0xDC00 && data[pos] <= 0xDFFF) {
+        uint32_t low = data[pos++];
+        return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return REPLACEMENT;
+}
+
+static idx_t Utf8Width(uint32_t code_point) {
+    return code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+}
+
+static void EncodeUtf8(uint32_t code_point, char* target) {
+    auto out = reinterpret_cast<unsigned char*>(target);
+    if (code_point < 0x80) {
+        out[0] = static_cast<unsigned char>(code_point);
+    } else if (code_point < 0x800) {
+        out[0] = static_cast<unsigned char>(0xC0 | (code_point >> 6));
+        out[1] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        out[0] = static_cast<unsigned char>(0xE0 | (code_point >> 12));
+        out[1] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+    } else {
+        out[0] = static_cast<unsigned char>(0xF0 | (code_point >> 18));
+        out[1] = static_cast<unsigned char>(0x80 | ((code_point >> 12) & 0x3F));
+        out[2] = static_cast<unsigned char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[3] = static_cast<unsigned char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+// ASCII values are narrowed in one pass; others are measured first and then encoded
+// straight into the string heap, so no intermediate string is built
+template <class CHAR_T>
+static string_t WideToVectorInternal(Vector& out, const CHAR_T* data, idx_t count, idx_t max_bytes,
+                                     bool& truncated) {
+    const idx_t limit = max_bytes ? max_bytes : NumericLimits<idx_t>::Maximum();
+    truncated = false;
+    if (IsAsciiWide(data, count)) {
+        truncated = count > limit;
+        idx_t length = MinValue<idx_t>(count, limit);
+        auto result = StringVector::EmptyString(out, length);
+        auto target = result.GetDataWriteable();
+        for (idx_t i = 0; i < length; i++) {
+            target[i] = static_cast<char>(data[i]);
+        }
+        result.Finalize();
+        return result;
+    }
+    
+    // Length of the whole characters that fit into the limit
+    idx_t length = 0;
+    idx_t units = 0;
+    for (idx_t pos = 0; pos < count;) {
+        idx_t width = Utf8Width(DecodeWide(data, count, pos));
+        if (length + width > limit) {
+            truncated = true;
+            break;
+        }
+        length += width;
+        units = pos;
+    }
+    
+    auto result = StringVector::EmptyString(out, length);
+    auto target = result.GetDataWriteable();
+    for (idx_t pos = 0; pos < units;) {
+        auto code_point = DecodeWide(data, units, pos);
+        EncodeUtf8(code_point, target);
+        target += Utf8Width(code_point);
+    }
+    result.Finalize();
+    return result;
+}
+
+string_t OdbcEncoding::WideToVector(Vector& out, const uint16_t* data, idx_t count, idx_t max_bytes,
+                                    bool& truncated) {
+    return WideToVectorInternal(out, data, count, max_bytes, truncated);
+}
+
+string_t OdbcEncoding::WideToVector(Vector& out, const uint32_t* data, idx_t count, idx_t max_bytes,
+                                    bool& truncated) {
+    return WideToVectorInternal(out, data, count, max_bytes, truncated);
+}
+
+template <class CHAR_T>
+static std::string WideToStringInternal(const CHAR_T* data, idx_t count) {
+    std::string result;
+    result.reserve(count);
+    char encoded[4];
+    for (idx_t pos = 0; pos < count;) {
+        auto code_point = DecodeWide(data, count, pos);
+        EncodeUtf8(code_point, encoded);
+        result.append(encoded, Utf8Width(code_point));
+    }
+    return result;
+}
+
+std::string OdbcEncoding::WideToString(const uint16_t* data, idx_t count) {
+    return WideToStringInternal(data, count);
+}
+
+std::string OdbcEncoding::WideToString(const uint32_t* data, idx_t count) {
+    return WideToStringInternal(data, count);
+}
+
+template <class CHAR_T>
+static void StringToWideInternal(const std::string& input, std::vector<CHAR_T>& out) {
+    out.clear();
+    out.reserve(input.size() + 1);
+    for (idx_t pos = 0; pos < input.size();) {
+        int length = 1;
+        auto code_point = Utf8Proc::UTF8ToCodepoint(input.data() + pos, length);
+        if (length <= 0 || code_point < 0) {
+            code_point = 0xFFFD;
+            length = 1;
+        }
+        pos += static_cast<idx_t>(length);
+        if (sizeof(CHAR_T) == 2 && code_point > 0xFFFF) {
+            code_point -= 0x10000;
+            out.push_back(static_cast<CHAR_T>(0xD800 + (code_point >> 10)));
+            out.push_back(static_cast<CHAR_T>(0xDC00 + (code_point & 0x3FF)));
+        } else {
+            out.push_back(static_cast<CHAR_T>(code_point));
+        }
+    }
+    out.push_back(0);
+}
+
+void OdbcEncoding::StringToWide(const std::string& input, std::vector<uint16_t>& out) {
+    StringToWideInternal(input, out);
+}
+
+void OdbcEncoding::StringToWide(const std::string& input, std::vector<uint32_t>& out) {
+    StringToWideInternal(input, out);
+}
+
 std::string OdbcEncoding::ConvertToUTF8(const std::string& input, const std::string& from_encoding) {
     if (input.empty() || !NeedsConversion(from_encoding)) {
         return input;
     }
     
+    OdbcEncodingConverter converter(from_encoding);
+    return converter.Convert(input);
+}
+
+//---------------------------------------------------------------------------
+// OdbcEncodingConverter implementation
+//---------------------------------------------------------------------------
+
+OdbcEncodingConverter::OdbcEncodingConverter(const std::string& encoding) : encoding(encoding) {
+    // The encoding was checked at bind time with OdbcEncoding::VerifyEncoding
 #ifdef _WIN32
-    int codepage = GetWindowsCodepage(from_encoding);
-    return ConvertToUTF8_Windows(input, codepage);
+    codepage = OdbcEncoding::GetWindowsCodepage(encoding);
 #else
-    return ConvertToUTF8_Unix(input, from_encoding);
+    descriptor = iconv_open("UTF-8", encoding.c_str());
+    if (descriptor == (iconv_t)-1) {
+        throw InvalidInputException("Unsupported encoding '%s'", encoding);
+    }
 #endif
 }
 
-#ifdef _WIN32
-std::string OdbcEncoding::ConvertToUTF8_Windows(const std::string& input, int codepage) {
-    if (input.empty()) {
+OdbcEncodingConverter::~OdbcEncodingConverter() {
+#ifndef _WIN32
+    if (descriptor != (iconv_t)-1) {
+        iconv_close(descriptor);
+    }
+#endif
+}
+
+string_t OdbcEncodingConverter::ConvertToVector(Vector& out, const char* data, idx_t length) {
+    if (OdbcEncoding::IsAscii(data, length)) {
+        return StringVector::AddString(out, data, length);
+    }
+    ConvertToBuffer(data, length);
+    return StringVector::AddString(out, buffer.data(), buffer.size());
+}
+
+std::string OdbcEncodingConverter::Convert(const std::string& input) {
+    if (OdbcEncoding::IsAscii(input.data(), input.size())) {
         return input;
     }
+    ConvertToBuffer(input.data(), input.size());
+    return std::string(buffer.data(), buffer.size());
+}
+
+// Raw bytes of another character set must never end up in a VARCHAR
+static void ThrowInvalidValue(const std::string& encoding) {
+    throw InvalidInputException("Invalid %s in a character value from the ODBC data source - set the "
+                                "'encoding' parameter to the character set of the data source", encoding);
+}
+
+#ifdef _WIN32
+void OdbcEncodingConverter::ConvertToBuffer(const char* data, idx_t length) {
+    if (length == 0) {
+        buffer.clear();
+        return;
+    }
     
-    // First, convert from specified codepage to UTF-16
-    int wide_size = MultiByteToWideChar(codepage, MB_ERR_INVALID_CHARS,
-                                      input.c_str(), -1, nullptr, 0);
-    
+    // First, convert from the codepage to UTF-16
+    int input_length = static_cast<int>(length);
+    int wide_size = MultiByteToWideChar(codepage, MB_ERR_INVALID_CHARS, data, input_length, nullptr, 0);
     if (wide_size == 0) {
-        // If conversion fails, return original string
-        return input;
+        ThrowInvalidValue(encoding);
     }
-    
-    std::vector<wchar_t> wide_str(wide_size);
-    if (MultiByteToWideChar(codepage, MB_ERR_INVALID_CHARS, 
-                           input.c_str(), -1, 
-                           wide_str.data(), wide_size) == 0) {
-        // If conversion fails, return original string
-        return input;
+    wide_buffer.resize(wide_size);
+    if (MultiByteToWideChar(codepage, MB_ERR_INVALID_CHARS, data, input_length, 
+                           wide_buffer.data(), wide_size) == 0) {
+        ThrowInvalidValue(encoding);
     }
     
     // Then convert from UTF-16 to UTF-8
-    int utf8_size = WideCharToMultiByte(CP_UTF8, 0,
-                                       wide_str.data(), -1,
-                                       nullptr, 0, nullptr, nullptr);
-    
+    int utf8_size = WideCharToMultiByte(CP_UTF8, 0, wide_buffer.data(), wide_size, nullptr, 0, nullptr, nullptr);
     if (utf8_size == 0) {
-        // If conversion fails, return original string
-        return input;
-    }
-    
-    std::vector<char> utf8_str(utf8_size);
-    if (WideCharToMultiByte(CP_UTF8, 0,
-                           wide_str.data(), -1,
-                           utf8_str.data(), utf8_size,
-                           nullptr, nullptr) == 0) {
-        // If conversion fails, return original string
-        return input;
+        ThrowInvalidValue(encoding);
     }
-    
-    // Remove null terminator if present
-    if (utf8_size > 0 && utf8_str[utf8_size - 1] == '\0') {
-        return std::string(utf8_str.data(), utf8_size - 1);
+    buffer.resize(utf8_size);
+    if (WideCharToMultiByte(CP_UTF8, 0, wide_buffer.data(), wide_size, 
+                           buffer.data(), utf8_size, nullptr, nullptr) == 0) {
+        ThrowInvalidValue(encoding);
     }
-    
-    return std::string(utf8_str.data(), utf8_size);
 }
 #else
-std::string OdbcEncoding::ConvertToUTF8_Unix(const std::string& input, const std::string& encoding) {
-    if (input.empty()) {
-        return input;
-    }
+void OdbcEncodingConverter::ConvertToBuffer(const char* data, idx_t length) {
+    // Reset the shift state left behind by the previous value
+    iconv(descriptor, nullptr, nullptr, nullptr, nullptr);
     
-    // On Unix systems, use iconv for conversion
-    iconv_t cd = iconv_open("UTF-8", encoding.c_str());
-    if (cd == (iconv_t)-1) {
-        // If we can't open the conversion, return original string
-        return input;
+    // UTF-8 takes at most 4 bytes per character; grow if a multi-byte input still overflows
+    if (buffer.size() < length * 4) {
+        buffer.resize(length * 4);
     }
+    char* in_ptr = const_cast<char*>(data);
+    size_t in_bytes_left = length;
+    size_t written = 0;
     
-    // Prepare input and output buffers
-    size_t in_bytes_left = input.length();
-    size_t out_bytes_left = in_bytes_left * 4; // UTF-8 can take up to 4 bytes per character
-    
-    std::vector<char> out_buffer(out_bytes_left);
-    
-    char* in_ptr = const_cast<char*>(input.c_str());
-    char* out_ptr = out_buffer.data();
-    
-    // Perform conversion
-    size_t result = iconv(cd, &in_ptr, &in_bytes_left, &out_ptr, &out_bytes_left);
-    
-    iconv_close(cd);
-    
-    if (result == (size_t)-1) {
-        // Conversion failed, return original string
-        return input;
+    while (true) {
+        char* out_ptr = buffer.data() + written;
+        size_t out_bytes_left = buffer.size() - written;
+        size_t result = iconv(descriptor, &in_ptr, &in_bytes_left, &out_ptr, &out_bytes_left);
+        written = buffer.size() - out_bytes_left;
+        if (result != (size_t)-1) {
+            break;
+        }
+        if (errno == EINVAL) {
+            // Incomplete multi-byte sequence at the end, i.e. a value that was cut to a
+            // length limit: drop the partial character
+            break;
+        }
+        if (errno != E2BIG) {
+            ThrowInvalidValue(encoding);
+        }
+        buffer.resize(buffer.size() * 2);
     }
     
-    // Calculate actual output size
-    size_t output_size = out_buffer.size() - out_bytes_left;
-    
-    return std::string(out_buffer.data(), output_size);
+    // buffer holds the converted value in its first written bytes
+    buffer.resize(written);
 }
 #endif
 
-} // namespace duckdb
\ No newline at end of file
+} // namespace duckdb
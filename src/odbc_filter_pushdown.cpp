@@ -0,0 +1,270 @@
+#include "odbc_filter_pushdown.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+
+namespace duckdb {
+
+// Optional and dynamic filters only help pruning - skipping them is always correct
+static bool IsOptionalFilter(const TableFilter &filter) {
+    return filter.filter_type == TableFilterType::OPTIONAL_FILTER ||
+           filter.filter_type == TableFilterType::DYNAMIC_FILTER;
+}
+
+static const char *GetComparisonOperator(ExpressionType type) {
+    switch (type) {
+        case ExpressionType::COMPARE_EQUAL:
+            return "=";
+        case ExpressionType::COMPARE_NOTEQUAL:
+            return "<>";
+        case ExpressionType::COMPARE_LESSTHAN:
+            return "<";
+        case ExpressionType::COMPARE_GREATERTHAN:
+            return ">";
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return "<=";
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return ">=";
+        default:
+            return nullptr;
+    }
+}
+
+// Translate a single filter on column. Returns false if nothing could be translated.
+// exact is cleared when the remote predicate only selects a superset of the rows
+// and the filter must be re-checked locally.
+static bool TransformFilter(const TableFilter &filter, const std::string &column, std::string &sql, bool &exact) {
+    switch (filter.filter_type) {
+        case TableFilterType::CONSTANT_COMPARISON: {
+            auto &constant_filter = filter.Cast<ConstantFilter>();
+            auto op = GetComparisonOperator(constant_filter.comparison_type);
+            std::string literal;
+            if (!op || !OdbcFilterPushdown::TryGetLiteral(constant_filter.constant, literal)) {
+                return false;
+            }
+            if (constant_filter.constant.type().id() == LogicalTypeId::VARCHAR) {
+                // Remote collations may ignore case or trailing blanks, so only equality is
+                // sent (it selects a superset of the matching rows) and it is re-checked locally
+                if (constant_filter.comparison_type != ExpressionType::COMPARE_EQUAL) {
+                    return false;
+                }
+                exact = false;
+            }
+            sql = column + " " + op + " " + literal;
+            return true;
+        }
+        
+        case TableFilterType::IS_NULL:
+            sql = column + " IS NULL";
+            return true;
+            
+        case TableFilterType::IS_NOT_NULL:
+            sql = column + " IS NOT NULL";
+            return true;
+            
+        case TableFilterType::IN_FILTER: {
+            auto &in_filter = filter.Cast<InFilter>();
+            std::vector<std::string> literals;
+            for (auto &value : in_filter.values) {
+                std::string literal;
+                if (!OdbcFilterPushdown::TryGetLiteral(value, literal)) {
+                    return false;
+                }
+                if (value.type().id() == LogicalTypeId::VARCHAR) {
+                    exact = false;
+                }
+                literals.push_back(std::move(literal));
+            }
+            if (literals.empty()) {
+                return false;
+            }
+            sql = column + " IN (" + StringUtil::Join(literals, ", ") + ")";
+            return true;
+        }
+        
+        case TableFilterType::CONJUNCTION_AND: {
+            // Untranslatable children are left out - the remaining ones still narrow the result
+            auto &conjunction = filter.Cast<ConjunctionAndFilter>();
+            std::vector<std::string> children;
+            for (auto &child : conjunction.child_filters) {
+                if (IsOptionalFilter(*child)) {
+                    continue;
+                }
+                std::string child_sql;
+                bool child_exact = true;
+                if (!TransformFilter(*child, column, child_sql, child_exact)) {
+                    exact = false;
+                    continue;
+                }
+                exact = exact && child_exact;
+                children.push_back("(" + child_sql + ")");
+            }
+            if (children.empty()) {
+                return false;
+            }
+            sql = StringUtil::Join(children, " AND ");
+            return true;
+        }
+        
+        case TableFilterType::CONJUNCTION_OR: {
+            // Every alternative must be translated, otherwise rows would be lost
+            auto &conjunction = filter.Cast<ConjunctionOrFilter>();
+            std::vector<std::string> children;
+            for (auto &child : conjunction.child_filters) {
+                std::string child_sql;
+                bool child_exact = true;
+                if (IsOptionalFilter(*child) || !TransformFilter(*child, column, child_sql, child_exact)) {
+                    return false;
+                }
+                exact = exact && child_exact;
+                children.push_back("(" + child_sql + ")");
+            }
+            if (children.empty()) {
+                return false;
+            }
+            sql = StringUtil::Join(children, " OR ");
+            return true;
+        }
+        
+        default:
+            return false;
+    }
+}
+
+std::string OdbcFilterPushdown::TransformFilters(const vector<column_t> &column_ids, const vector<LogicalType> &types,
+                                                 const vector<std::string> &names,
+                                                 optional_ptr<TableFilterSet> filters, bool enabled,
+                                                 unique_ptr<Expression> &residual) {
+    if (!filters || filters->filters.empty()) {
+        return std::string();
+    }
+    
+    std::vector<std::string> predicates;
+    vector<unique_ptr<Expression>> local_filters;
+    for (auto &entry : filters->filters) {
+        // Filters are keyed by their position in column_ids, i.e. the output column
+        auto output_idx = entry.first;
+        auto &filter = *entry.second;
+        if (IsOptionalFilter(filter)) {
+            continue;
+        }
+        
+        auto column_id = column_ids[output_idx];
+        std::string sql;
+        bool exact = true;
+        bool pushed = false;
+        if (enabled && column_id != COLUMN_IDENTIFIER_ROW_ID) {
+            auto column = "\"" + OdbcUtils::SanitizeString(names[column_id]) + "\"";
+            pushed = TransformFilter(filter, column, sql, exact);
+        }
+        
+        if (pushed) {
+            predicates.push_back("(" + sql + ")");
+        }
+        if (!pushed || !exact) {
+            BoundReferenceExpression column_ref(types[output_idx], output_idx);
+            local_filters.push_back(filter.ToExpression(column_ref));
+        }
+    }
+    
+    if (local_filters.size() == 1) {
+        residual = std::move(local_filters[0]);
+    } else if (!local_filters.empty()) {
+        auto conjunction = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
+        for (auto &local_filter : local_filters) {
+            conjunction->children.push_back(std::move(local_filter));
+        }
+        residual = std::move(conjunction);
+    }
+    
+    return StringUtil::Join(predicates, " AND ");
+}
+
+// ODBC escape clauses only cover years 0001-9999
+static bool IsEscapableYear(int32_t year) {
+    return year >= 1 && year <= 9999;
+}
+
+bool OdbcFilterPushdown::TryGetLiteral(const Value &value, std::string &literal) {
+    if (value.IsNull()) {
+        return false;
+    }
+    
+    switch (value.type().id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::HUGEINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::UBIGINT:
+        case LogicalTypeId::UHUGEINT:
+        case LogicalTypeId::DECIMAL:
+            literal = value.ToString();
+            return true;
+            
+        case LogicalTypeId::DOUBLE: {
+            // FLOAT constants are not pushed: most databases would widen them to
+            // DOUBLE and no longer match the stored REAL values exactly
+            auto number = value.GetValue<double>();
+            if (!Value::IsFinite(number)) {
+                return false;
+            }
+            literal = value.ToString();
+            return true;
+        }
+        
+        case LogicalTypeId::VARCHAR: {
+            auto &str = StringValue::Get(value);
+            if (str.find('\0') != std::string::npos) {
+                return false;
+            }
+            literal = "'" + StringUtil::Replace(str, "'", "''") + "'";
+            return true;
+        }
+        
+        case LogicalTypeId::DATE: {
+            auto date = value.GetValue<date_t>();
+            if (!Date::IsFinite(date) || !IsEscapableYear(Date::ExtractYear(date))) {
+                return false;
+            }
+            literal = "{d '" + Date::ToString(date) + "'}";
+            return true;
+        }
+        
+        case LogicalTypeId::TIME: {
+            // The {t} escape has no fractional seconds
+            auto time = value.GetValue<dtime_t>();
+            if (time.micros % Interval::MICROS_PER_SEC != 0) {
+                return false;
+            }
+            literal = "{t '" + Time::ToString(time) + "'}";
+            return true;
+        }
+        
+        case LogicalTypeId::TIMESTAMP: {
+            auto timestamp = value.GetValue<timestamp_t>();
+            if (!Timestamp::IsFinite(timestamp) || 
+                !IsEscapableYear(Date::ExtractYear(Timestamp::GetDate(timestamp)))) {
+                return false;
+            }
+            literal = "{ts '" + Timestamp::ToString(timestamp) + "'}";
+            return true;
+        }
+        
+        default:
+            // Booleans and other types have no portable literal across drivers
+            return false;
+    }
+}
+
+} // namespace duckdb
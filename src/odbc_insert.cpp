@@ -0,0 +1,596 @@
+#include "odbc_insert.hpp"
+#include "odbc_utils.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_driver_info.hpp"
+#include "odbc_result_cache.hpp"
+#include "odbc_cancel.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Parameter types
+//------------------------------------------------------------------------------
+
+static OdbcInsertKind GetInsertKind(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::BOOLEAN:
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::SMALLINT:
+            return OdbcInsertKind::SMALLINT;
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::INTEGER:
+            return OdbcInsertKind::INTEGER;
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::BIGINT:
+            return OdbcInsertKind::BIGINT;
+        case LogicalTypeId::FLOAT:
+            return OdbcInsertKind::FLOAT;
+        case LogicalTypeId::DOUBLE:
+            return OdbcInsertKind::DOUBLE;
+        case LogicalTypeId::DATE:
+            return OdbcInsertKind::DATE;
+        case LogicalTypeId::TIME:
+            return OdbcInsertKind::TIME;
+        case LogicalTypeId::TIMESTAMP:
+            return OdbcInsertKind::TIMESTAMP;
+        case LogicalTypeId::BLOB:
+            return OdbcInsertKind::BINARY;
+        default:
+            // VARCHAR, and DECIMAL, HUGEINT, UUID, ... sent as their text form
+            return OdbcInsertKind::STRING;
+    }
+}
+
+static idx_t GetValueWidth(OdbcInsertKind kind) {
+    switch (kind) {
+        case OdbcInsertKind::SMALLINT:
+            return sizeof(short);
+        case OdbcInsertKind::INTEGER:
+            return sizeof(int);
+        case OdbcInsertKind::BIGINT:
+            return sizeof(long long);
+        case OdbcInsertKind::FLOAT:
+            return sizeof(float);
+        case OdbcInsertKind::DOUBLE:
+            return sizeof(double);
+        case OdbcInsertKind::DATE:
+            return sizeof(nanodbc::date);
+        case OdbcInsertKind::TIMESTAMP:
+            return sizeof(nanodbc::timestamp);
+        default:
+            return 0;
+    }
+}
+
+// Parameter description used when the driver does not implement SQLDescribeParam
+static void SetDefaultParameterType(OdbcInsertColumn &column) {
+    column.decimal_digits = 0;
+    switch (column.kind) {
+        case OdbcInsertKind::SMALLINT:
+            if (column.type.id() == LogicalTypeId::BOOLEAN) {
+                column.sql_type = SQL_BIT;
+                column.column_size = 1;
+            } else {
+                column.sql_type = SQL_SMALLINT;
+                column.column_size = 5;
+            }
+            break;
+        case OdbcInsertKind::INTEGER:
+            column.sql_type = SQL_INTEGER;
+            column.column_size = 10;
+            break;
+        case OdbcInsertKind::BIGINT:
+            column.sql_type = SQL_BIGINT;
+            column.column_size = 19;
+            break;
+        case OdbcInsertKind::FLOAT:
+            column.sql_type = SQL_REAL;
+            column.column_size = 7;
+            break;
+        case OdbcInsertKind::DOUBLE:
+            column.sql_type = SQL_DOUBLE;
+            column.column_size = 15;
+            break;
+        case OdbcInsertKind::DATE:
+            column.sql_type = SQL_TYPE_DATE;
+            column.column_size = 10;
+            break;
+        case OdbcInsertKind::TIME:
+            column.sql_type = SQL_TYPE_TIME;
+            column.column_size = 15;
+            column.decimal_digits = 6;
+            break;
+        case OdbcInsertKind::TIMESTAMP:
+            column.sql_type = SQL_TYPE_TIMESTAMP;
+            column.column_size = 26;
+            column.decimal_digits = 6;
+            break;
+        case OdbcInsertKind::STRING:
+            // Sized from the longest value of each batch
+            column.sql_type = SQL_VARCHAR;
+            column.column_size = 0;
+            break;
+        case OdbcInsertKind::BINARY:
+            column.sql_type = SQL_VARBINARY;
+            column.column_size = 0;
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Value conversion
+//------------------------------------------------------------------------------
+
+template <class SRC, class DST>
+static DST ToParameter(SRC value) {
+    return static_cast<DST>(value);
+}
+
+template <>
+nanodbc::date ToParameter<date_t, nanodbc::date>(date_t value) {
+    if (!Date::IsFinite(value)) {
+        throw InvalidInputException("Cannot insert infinite DATE value into an ODBC data source");
+    }
+    int32_t year, month, day;
+    Date::Convert(value, year, month, day);
+    nanodbc::date result;
+    result.year = static_cast<std::int16_t>(year);
+    result.month = static_cast<std::int16_t>(month);
+    result.day = static_cast<std::int16_t>(day);
+    return result;
+}
+
+template <>
+nanodbc::timestamp ToParameter<timestamp_t, nanodbc::timestamp>(timestamp_t value) {
+    if (!Timestamp::IsFinite(value)) {
+        throw InvalidInputException("Cannot insert infinite TIMESTAMP value into an ODBC data source");
+    }
+    date_t date;
+    dtime_t time;
+    Timestamp::Convert(value, date, time);
+    int32_t year, month, day, hour, minute, second, micros;
+    Date::Convert(date, year, month, day);
+    Time::Convert(time, hour, minute, second, micros);
+    nanodbc::timestamp result;
+    result.year = static_cast<std::int16_t>(year);
+    result.month = static_cast<std::int16_t>(month);
+    result.day = static_cast<std::int16_t>(day);
+    result.hour = static_cast<std::int16_t>(hour);
+    result.min = static_cast<std::int16_t>(minute);
+    result.sec = static_cast<std::int16_t>(second);
+    result.fract = micros * 1000;  // nanoseconds
+    return result;
+}
+
+// Copy rows [offset, offset + count) of source into the parameter array at pos
+template <class SRC, class DST>
+static void AppendValues(OdbcInsertColumn &column, const UnifiedVectorFormat &format,
+                         idx_t offset, idx_t count, idx_t pos) {
+    auto source = UnifiedVectorFormat::GetData<SRC>(format);
+    auto target = reinterpret_cast<DST *>(column.values.get()) + pos;
+    auto nulls = column.nulls.get() + pos;
+    for (idx_t i = 0; i < count; i++) {
+        auto idx = format.sel->get_index(offset + i);
+        nulls[i] = !format.validity.RowIsValid(idx);
+        if (!nulls[i]) {
+            target[i] = ToParameter<SRC, DST>(source[idx]);
+        }
+    }
+}
+
+static void AppendStrings(OdbcInsertColumn &column, const UnifiedVectorFormat &format,
+                          idx_t offset, idx_t count, idx_t pos) {
+    auto source = UnifiedVectorFormat::GetData<string_t>(format);
+    auto nulls = column.nulls.get() + pos;
+    for (idx_t i = 0; i < count; i++) {
+        auto idx = format.sel->get_index(offset + i);
+        nulls[i] = !format.validity.RowIsValid(idx);
+        if (column.kind == OdbcInsertKind::BINARY) {
+            auto &blob = column.blobs[pos + i];
+            if (nulls[i]) {
+                blob.clear();
+            } else {
+                auto data = reinterpret_cast<const uint8_t *>(source[idx].GetData());
+                blob.assign(data, data + source[idx].GetSize());
+            }
+        } else {
+            auto &str = column.strings[pos + i];
+            if (nulls[i]) {
+                str.clear();
+            } else {
+                str.assign(source[idx].GetData(), source[idx].GetSize());
+            }
+        }
+    }
+}
+
+// TIME values are sent as text: the fraction of SQL_TIME_STRUCT cannot hold microseconds
+static void AppendTimes(OdbcInsertColumn &column, const UnifiedVectorFormat &format,
+                        idx_t offset, idx_t count, idx_t pos) {
+    auto source = UnifiedVectorFormat::GetData<dtime_t>(format);
+    auto nulls = column.nulls.get() + pos;
+    // Drivers reject fractions finer than the column's precision (e.g. TIME(0))
+    auto digits = column.decimal_digits >= 0 ? MinValue<SQLSMALLINT>(column.decimal_digits, 6) : 6;
+    for (idx_t i = 0; i < count; i++) {
+        auto idx = format.sel->get_index(offset + i);
+        nulls[i] = !format.validity.RowIsValid(idx);
+        auto &str = column.strings[pos + i];
+        if (nulls[i]) {
+            str.clear();
+            continue;
+        }
+        int32_t hour, minute, second, micros;
+        Time::Convert(source[idx], hour, minute, second, micros);
+        str = StringUtil::Format("%02d:%02d:%02d", hour, minute, second);
+        if (digits > 0) {
+            auto fraction = StringUtil::Format("%06d", micros);
+            str += "." + fraction.substr(0, static_cast<idx_t>(digits));
+        }
+    }
+}
+
+static void AppendColumn(OdbcInsertColumn &column, Vector &source, idx_t source_count,
+                         idx_t offset, idx_t count, idx_t pos) {
+    UnifiedVectorFormat format;
+    source.ToUnifiedFormat(source_count, format);
+
+    switch (column.type.id()) {
+        case LogicalTypeId::BOOLEAN:
+            AppendValues<bool, short>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::TINYINT:
+            AppendValues<int8_t, short>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::UTINYINT:
+            AppendValues<uint8_t, short>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::SMALLINT:
+            AppendValues<int16_t, short>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::USMALLINT:
+            AppendValues<uint16_t, int>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::INTEGER:
+            AppendValues<int32_t, int>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::UINTEGER:
+            AppendValues<uint32_t, long long>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::BIGINT:
+            AppendValues<int64_t, long long>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::FLOAT:
+            AppendValues<float, float>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::DOUBLE:
+            AppendValues<double, double>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::DATE:
+            AppendValues<date_t, nanodbc::date>(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::TIME:
+            AppendTimes(column, format, offset, count, pos);
+            break;
+        case LogicalTypeId::TIMESTAMP: {
+            AppendValues<timestamp_t, nanodbc::timestamp>(column, format, offset, count, pos);
+            // Drivers reject fractions finer than the column's precision (e.g. DATETIME)
+            if (column.decimal_digits >= 0 && column.decimal_digits < 9) {
+                int32_t unit = 1;
+                for (auto digits = column.decimal_digits; digits < 9; digits++) {
+                    unit *= 10;
+                }
+                auto values = reinterpret_cast<nanodbc::timestamp *>(column.values.get()) + pos;
+                for (idx_t i = 0; i < count; i++) {
+                    values[i].fract -= values[i].fract % unit;
+                }
+            }
+            break;
+        }
+        default:
+            AppendStrings(column, format, offset, count, pos);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Writer
+//------------------------------------------------------------------------------
+
+static void BeginTransaction(OdbcInsertLocalState &state) {
+    try {
+        state.transaction = make_uniq<nanodbc::transaction>(state.connection->GetNativeConnection());
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("begin transaction", e);
+    }
+}
+
+static void CommitTransaction(OdbcInsertLocalState &state) {
+    try {
+        state.transaction->commit();
+        state.transaction.reset();
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("commit transaction", e);
+    }
+    state.rows_since_commit = 0;
+}
+
+// Connect and prepare the INSERT on the first rows a thread receives
+static void InitializeWriter(ClientContext &context, const OdbcInsertFunctionData &bind_data,
+                             OdbcInsertLocalState &state) {
+    state.connection = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+    state.statement = state.connection->Prepare(bind_data.insert_sql);
+    state.statement->SetQueryTimeout(bind_data.query_timeout);
+    state.batch_size = state.connection->GetDriverInfo().param_arrays ? bind_data.batch_size : 1;
+
+    auto handle = state.statement->GetNativeHandle();
+    for (idx_t col_idx = 0; col_idx < bind_data.column_types.size(); col_idx++) {
+        OdbcInsertColumn column;
+        column.type = bind_data.column_types[col_idx];
+        column.kind = GetInsertKind(column.type);
+        column.cast_to_varchar = column.kind == OdbcInsertKind::STRING &&
+                                 column.type.id() != LogicalTypeId::VARCHAR;
+
+        // Prefer the target column's own type, size and precision
+        SQLSMALLINT nullable;
+        auto ret = SQLDescribeParam(handle, static_cast<SQLUSMALLINT>(col_idx + 1), &column.sql_type,
+                                    &column.column_size, &column.decimal_digits, &nullable);
+        column.described = SQL_SUCCEEDED(ret);
+        if (!column.described) {
+            SetDefaultParameterType(column);
+        }
+
+        column.value_width = GetValueWidth(column.kind);
+        if (column.value_width > 0) {
+            column.values = make_unsafe_uniq_array<data_t>(column.value_width * state.batch_size);
+        } else if (column.kind == OdbcInsertKind::BINARY) {
+            column.blobs.resize(state.batch_size);
+        } else {
+            column.strings.resize(state.batch_size);
+        }
+        column.nulls = make_unsafe_uniq_array<bool>(state.batch_size);
+        state.columns.push_back(std::move(column));
+    }
+
+    BeginTransaction(state);
+}
+
+// Bind the pending rows as parameter arrays and send them with one execute
+static void FlushBatch(ClientContext &context, const OdbcInsertFunctionData &bind_data, OdbcInsertLocalState &state) {
+    if (state.pending == 0) {
+        return;
+    }
+
+    auto &stmt = state.statement->stmt;
+    auto count = state.pending;
+    try {
+        // Describe every parameter ourselves so nanodbc does not call SQLDescribeParam
+        // again; character and binary sizes follow the longest value when unknown
+        std::vector<short> indexes, types, scales;
+        std::vector<unsigned long> sizes;
+        for (idx_t col_idx = 0; col_idx < state.columns.size(); col_idx++) {
+            auto &column = state.columns[col_idx];
+            auto size = column.column_size;
+            if (column.kind == OdbcInsertKind::STRING || column.kind == OdbcInsertKind::BINARY) {
+                idx_t max_length = 1;
+                for (idx_t row = 0; row < count; row++) {
+                    auto length = column.kind == OdbcInsertKind::STRING ? column.strings[row].size()
+                                                                         : column.blobs[row].size();
+                    max_length = MaxValue<idx_t>(max_length, length);
+                }
+                if (!column.described || size == 0) {
+                    size = max_length;
+                }
+            }
+            indexes.push_back(static_cast<short>(col_idx));
+            types.push_back(column.sql_type);
+            sizes.push_back(static_cast<unsigned long>(size));
+            scales.push_back(column.decimal_digits);
+        }
+        stmt.describe_parameters(indexes, types, sizes, scales);
+
+        for (idx_t col_idx = 0; col_idx < state.columns.size(); col_idx++) {
+            auto &column = state.columns[col_idx];
+            auto param = static_cast<short>(col_idx);
+            auto nulls = column.nulls.get();
+            switch (column.kind) {
+                case OdbcInsertKind::SMALLINT:
+                    stmt.bind(param, reinterpret_cast<const short *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::INTEGER:
+                    stmt.bind(param, reinterpret_cast<const int *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::BIGINT:
+                    stmt.bind(param, reinterpret_cast<const long long *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::FLOAT:
+                    stmt.bind(param, reinterpret_cast<const float *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::DOUBLE:
+                    stmt.bind(param, reinterpret_cast<const double *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::DATE:
+                    stmt.bind(param, reinterpret_cast<const nanodbc::date *>(column.values.get()), count, nulls);
+                    break;
+                case OdbcInsertKind::TIMESTAMP:
+                    stmt.bind(param, reinterpret_cast<const nanodbc::timestamp *>(column.values.get()), count,
+                              nulls);
+                    break;
+                case OdbcInsertKind::TIME:
+                case OdbcInsertKind::STRING:
+                    // The vector length is the batch size
+                    column.strings.resize(count);
+                    stmt.bind_strings(param, column.strings, nulls);
+                    column.strings.resize(state.batch_size);
+                    break;
+                case OdbcInsertKind::BINARY:
+                    column.blobs.resize(count);
+                    stmt.bind(param, column.blobs, nulls);
+                    column.blobs.resize(state.batch_size);
+                    break;
+            }
+        }
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("bind insert parameters", e);
+    }
+
+    {
+        OdbcCancelGuard cancel(context, state.statement->GetNativeHandle(), bind_data.query_timeout, "query_timeout");
+        try {
+            state.statement->ExecuteBatch(count);
+        } catch (...) {
+            cancel.ThrowIfCancelled();
+            throw;
+        }
+    }
+
+    // Cached results of the table are out of date
+    OdbcResultCache::Get(context)->Clear();
+
+    state.pending = 0;
+    state.rows_inserted += count;
+    state.rows_since_commit += count;
+    if (bind_data.commit_interval > 0 && state.rows_since_commit >= bind_data.commit_interval) {
+        CommitTransaction(state);
+        BeginTransaction(state);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Table function
+//------------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> BindOdbcInsert(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+    auto params = OdbcParameterParser::ParseInsertParameters(input);
+    if (params.table_name.empty()) {
+        throw BinderException("Parameter 'table_name' must not be empty");
+    }
+
+    auto result = make_uniq<OdbcInsertFunctionData>();
+    result->connection_params = params.connection;
+    result->table_name = params.table_name;
+    result->batch_size = params.options.batch_size;
+    result->commit_interval = params.commit_interval;
+    result->query_timeout = params.options.query_timeout;
+
+    // Columns are matched to the target table by the names of the input query
+    result->column_names = input.input_table_names;
+    result->column_types = input.input_table_types;
+    if (result->column_names.empty()) {
+        throw BinderException("odbc_insert requires an input query with at least one column");
+    }
+
+    std::string column_list;
+    std::string markers;
+    for (idx_t i = 0; i < result->column_names.size(); i++) {
+        if (i > 0) {
+            column_list += ", ";
+            markers += ", ";
+        }
+        column_list += "\"" + OdbcUtils::SanitizeString(result->column_names[i]) + "\"";
+        markers += "?";
+    }
+    result->insert_sql = "INSERT INTO \"" + OdbcUtils::SanitizeString(result->table_name) + "\" (" +
+                         column_list + ") VALUES (" + markers + ")";
+
+    return_types.emplace_back(LogicalType::BIGINT);
+    names.emplace_back("rows_inserted");
+
+    return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> InitOdbcInsertLocalState(ExecutionContext &context,
+                                                                    TableFunctionInitInput &input,
+                                                                    GlobalTableFunctionState *global_state) {
+    return make_uniq<OdbcInsertLocalState>();
+}
+
+static OperatorResultType OdbcInsertInOut(ExecutionContext &context, TableFunctionInput &data,
+                                          DataChunk &input, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<OdbcInsertFunctionData>();
+    auto &state = data.local_state->Cast<OdbcInsertLocalState>();
+    output.SetCardinality(0);
+
+    auto count = input.size();
+    if (count == 0) {
+        return OperatorResultType::NEED_MORE_INPUT;
+    }
+    if (!state.statement) {
+        InitializeWriter(context.client, bind_data, state);
+    }
+
+    // Types without a native parameter binding are sent as text
+    vector<unique_ptr<Vector>> casts(state.columns.size());
+    for (idx_t col_idx = 0; col_idx < state.columns.size(); col_idx++) {
+        if (state.columns[col_idx].cast_to_varchar) {
+            casts[col_idx] = make_uniq<Vector>(LogicalType::VARCHAR, count);
+            VectorOperations::DefaultCast(input.data[col_idx], *casts[col_idx], count);
+        }
+    }
+
+    idx_t offset = 0;
+    while (offset < count) {
+        auto rows = MinValue<idx_t>(state.batch_size - state.pending, count - offset);
+        for (idx_t col_idx = 0; col_idx < state.columns.size(); col_idx++) {
+            auto &source = casts[col_idx] ? *casts[col_idx] : input.data[col_idx];
+            AppendColumn(state.columns[col_idx], source, count, offset, rows, state.pending);
+        }
+        state.pending += rows;
+        offset += rows;
+        if (state.pending == state.batch_size) {
+            FlushBatch(context.client, bind_data, state);
+        }
+    }
+
+    return OperatorResultType::NEED_MORE_INPUT;
+}
+
+static OperatorFinalizeResultType OdbcInsertFinal(ExecutionContext &context, TableFunctionInput &data,
+                                                  DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<OdbcInsertFunctionData>();
+    auto &state = data.local_state->Cast<OdbcInsertLocalState>();
+
+    if (!state.finished) {
+        if (state.statement) {
+            FlushBatch(context.client, bind_data, state);
+            if (state.transaction) {
+                CommitTransaction(state);
+            }
+        }
+        state.finished = true;
+    }
+
+    // One row per writer thread
+    output.SetCardinality(1);
+    output.SetValue(0, 0, Value::BIGINT(static_cast<int64_t>(state.rows_inserted)));
+    return OperatorFinalizeResultType::FINISHED;
+}
+
+TableFunction OdbcInsertFunction() {
+    TableFunction result("odbc_insert", {LogicalType::TABLE}, nullptr, BindOdbcInsert, nullptr,
+                         InitOdbcInsertLocalState);
+    result.in_out_function = OdbcInsertInOut;
+    result.in_out_function_final = OdbcInsertFinal;
+
+    // Add named parameters
+    result.named_parameters["connection"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["table_name"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["username"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["password"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["isolation"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["query_timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["batch_size"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["commit_interval"] = LogicalType(LogicalTypeId::BIGINT);
+
+    return result;
+}
+
+} // namespace duckdb
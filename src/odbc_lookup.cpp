@@ -0,0 +1,299 @@
+#include "odbc_lookup.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_driver_info.hpp"
+#include "odbc_cancel.hpp"
+#include "odbc_scanner.hpp"
+#include "odbc_schema_cache.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parser/column_list.hpp"
+
+namespace duckdb {
+
+OdbcLookupLocalState::~OdbcLookupLocalState() {
+    if (statement && connection) {
+        connection->ReleaseStatement(std::move(statement));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Lookup batches
+//------------------------------------------------------------------------------
+
+bool OdbcLookupGlobalState::ClaimKey(const Value &key, idx_t capacity) {
+    auto entry = sent_keys.find(key);
+    if (entry != sent_keys.end()) {
+        recent_keys.splice(recent_keys.begin(), recent_keys, entry->second);
+        return false;
+    }
+    recent_keys.push_front(key);
+    sent_keys.emplace(key, recent_keys.begin());
+    if (recent_keys.size() > capacity) {
+        sent_keys.erase(recent_keys.back());
+        recent_keys.pop_back();
+    }
+    return true;
+}
+
+// Add the non-NULL keys of the input that have not been sent recently, from input_offset on,
+// until the batch is full
+static void CollectKeys(const OdbcLookupFunctionData &bind_data, OdbcLookupGlobalState &global_state,
+                        OdbcLookupLocalState &state, DataChunk &input) {
+    auto batch_size = bind_data.options.batch_size;
+    // Keys are never repeated within a batch
+    auto capacity = MaxValue<idx_t>(OdbcLookupParameters::MAX_SENT_KEYS, batch_size);
+    lock_guard<mutex> guard(global_state.lock);
+    while (state.input_offset < input.size() && state.keys.size() < batch_size) {
+        auto key = input.GetValue(0, state.input_offset++);
+        // NULL never matches; a key sent recently, by this or another thread, would return its rows twice
+        if (key.IsNull() || !global_state.ClaimKey(key, capacity)) {
+            continue;
+        }
+        state.keys.push_back(std::move(key));
+    }
+}
+
+// Send the collected keys as one query. The batch is padded with its last key so that
+// every query has the same text and runs the same prepared statement.
+static void ExecuteBatch(ClientContext &context, const OdbcLookupFunctionData &bind_data,
+                         OdbcLookupLocalState &state) {
+    D_ASSERT(!state.statement && !state.keys.empty());
+    if (!state.connection) {
+        state.connection = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+    }
+    state.statement = state.connection->PrepareCached(bind_data.lookup_sql);
+    // Rows per fetch only; the keys are bound as single values of one parameter set
+    state.statement->SetRowsetSize(state.connection->GetDriverInfo().LimitRowsetSize(bind_data.options.batch_size));
+    state.statement->SetQueryTimeout(bind_data.options.query_timeout);
+    for (idx_t i = 0; i < bind_data.options.batch_size; i++) {
+        state.statement->BindParameter(i, state.keys[MinValue<idx_t>(i, state.keys.size() - 1)]);
+    }
+    state.keys.clear();
+}
+
+// Copy rows of the running query into output from out_idx on, returns the new row count.
+// The statement goes back to the cache once its rows are exhausted.
+static idx_t FillOutput(ClientContext &context, const OdbcLookupFunctionData &bind_data, OdbcLookupLocalState &state,
+                        DataChunk &output, idx_t out_idx) {
+    while (out_idx < STANDARD_VECTOR_SIZE) {
+        bool has_row;
+        {
+            // The first step executes the query
+            bool executed = state.statement->IsExecuted();
+            OdbcCancelGuard cancel(context, state.statement->GetNativeHandle(),
+                                   executed ? bind_data.options.fetch_timeout : bind_data.options.query_timeout,
+                                   executed ? "fetch_timeout" : "query_timeout");
+            try {
+                has_row = state.statement->Step();
+            } catch (...) {
+                cancel.ThrowIfCancelled();
+                throw;
+            }
+        }
+        if (!has_row) {
+            state.connection->ReleaseStatement(std::move(state.statement));
+            break;
+        }
+        for (idx_t col_idx = 0; col_idx < output.ColumnCount(); col_idx++) {
+            ConvertRowValue(*state.statement, state.encoding_converter.get(), state.long_columns, col_idx,
+                            output.data[col_idx], out_idx);
+        }
+        out_idx++;
+    }
+    return out_idx;
+}
+
+//------------------------------------------------------------------------------
+// Table function
+//------------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> BindOdbcLookup(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+    auto params = OdbcParameterParser::ParseLookupParameters(input);
+    if (params.table_name.empty()) {
+        throw BinderException("Parameter 'table_name' must not be empty");
+    }
+    if (input.input_table_types.size() != 1) {
+        throw BinderException("odbc_lookup requires an input query with exactly one key column");
+    }
+
+    auto result = make_uniq<OdbcLookupFunctionData>();
+    result->connection_params = params.connection;
+    result->table_name = params.table_name;
+    result->options = params.options;
+
+    // Columns of the remote table, from the schema cache if odbc_scan read them recently
+    OdbcSchema schema;
+    auto schema_cache = OdbcSchemaCache::Get(context);
+    auto cache_key = OdbcSchemaCache::TableKey(result->connection_params, result->table_name,
+                                               result->options.all_varchar);
+    if (!schema_cache->Lookup(cache_key, schema)) {
+        try {
+            auto db = OdbcConnectionPool::Acquire(context, result->connection_params);
+            ColumnList columns;
+            std::vector<std::unique_ptr<Constraint>> constraints;
+            db->GetTableInfo(result->table_name, columns, constraints, result->options.all_varchar);
+            for (auto &column : columns.Logical()) {
+                schema.names.push_back(column.GetName());
+                schema.types.push_back(column.GetType());
+            }
+        } catch (const nanodbc::database_error &e) {
+            OdbcUtils::ThrowException("bind lookup function", e);
+        }
+        if (schema.names.empty()) {
+            throw BinderException("No columns found for table " + result->table_name);
+        }
+    }
+
+    // Output the key column first, then the requested columns (default: all others)
+    auto find_column = [&](const std::string &name) -> idx_t {
+        for (idx_t i = 0; i < schema.names.size(); i++) {
+            if (StringUtil::CIEquals(schema.names[i], name)) {
+                return i;
+            }
+        }
+        throw BinderException("Column '%s' not found in table '%s'", name, result->table_name);
+    };
+    auto key_name = params.key.empty() ? input.input_table_names[0] : params.key;
+    auto key_index = find_column(key_name);
+    std::vector<idx_t> column_indexes {key_index};
+    if (params.columns.empty()) {
+        for (idx_t i = 0; i < schema.names.size(); i++) {
+            if (i != key_index) {
+                column_indexes.push_back(i);
+            }
+        }
+    } else {
+        for (auto &name : params.columns) {
+            auto index = find_column(name);
+            if (std::find(column_indexes.begin(), column_indexes.end(), index) == column_indexes.end()) {
+                column_indexes.push_back(index);
+            }
+        }
+    }
+
+    std::string column_list;
+    for (auto index : column_indexes) {
+        if (!column_list.empty()) {
+            column_list += ", ";
+        }
+        column_list += "\"" + OdbcUtils::SanitizeString(schema.names[index]) + "\"";
+        result->column_names.push_back(schema.names[index]);
+        result->column_types.push_back(schema.types[index]);
+    }
+    // Batches above the IN list limit of some databases are split into several lists
+    auto key_column = "\"" + OdbcUtils::SanitizeString(schema.names[key_index]) + "\"";
+    std::string condition;
+    for (idx_t i = 0; i < result->options.batch_size; i++) {
+        if (i % OdbcLookupParameters::MAX_IN_LIST_SIZE == 0) {
+            condition += i == 0 ? key_column + " IN (?" : ") OR " + key_column + " IN (?";
+        } else {
+            condition += ", ?";
+        }
+    }
+    condition += ")";
+    result->lookup_sql = "SELECT " + column_list + " FROM \"" + OdbcUtils::SanitizeString(result->table_name) +
+                         "\" WHERE " + condition;
+
+    names = result->column_names;
+    return_types = result->column_types;
+    return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> InitOdbcLookupGlobalState(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+    return make_uniq<OdbcLookupGlobalState>();
+}
+
+static unique_ptr<LocalTableFunctionState> InitOdbcLookupLocalState(ExecutionContext &context,
+                                                                    TableFunctionInitInput &input,
+                                                                    GlobalTableFunctionState *global_state) {
+    auto &bind_data = input.bind_data->Cast<OdbcLookupFunctionData>();
+    auto result = make_uniq<OdbcLookupLocalState>();
+    if (OdbcEncoding::NeedsConversion(bind_data.options.encoding)) {
+        result->encoding_converter = make_uniq<OdbcEncodingConverter>(bind_data.options.encoding);
+    }
+    result->long_columns = CreateLongColumnBuffers(bind_data.column_types, bind_data.options,
+                                                   result->encoding_converter.get());
+    return std::move(result);
+}
+
+static OperatorResultType OdbcLookupInOut(ExecutionContext &context, TableFunctionInput &data,
+                                          DataChunk &input, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<OdbcLookupFunctionData>();
+    auto &global_state = data.global_state->Cast<OdbcLookupGlobalState>();
+    auto &state = data.local_state->Cast<OdbcLookupLocalState>();
+
+    idx_t out_idx = 0;
+    while (true) {
+        // Rows of the previous batch come first
+        if (state.statement) {
+            out_idx = FillOutput(context.client, bind_data, state, output, out_idx);
+            if (out_idx == STANDARD_VECTOR_SIZE) {
+                output.SetCardinality(out_idx);
+                return OperatorResultType::HAVE_MORE_OUTPUT;
+            }
+        }
+        if (state.input_offset >= input.size()) {
+            state.input_offset = 0;
+            output.SetCardinality(out_idx);
+            return OperatorResultType::NEED_MORE_INPUT;
+        }
+        CollectKeys(bind_data, global_state, state, input);
+        if (state.keys.size() == bind_data.options.batch_size) {
+            ExecuteBatch(context.client, bind_data, state);
+        }
+    }
+}
+
+static OperatorFinalizeResultType OdbcLookupFinal(ExecutionContext &context, TableFunctionInput &data,
+                                                  DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<OdbcLookupFunctionData>();
+    auto &state = data.local_state->Cast<OdbcLookupLocalState>();
+
+    // Send the last, partial batch and return the rest of its rows
+    idx_t out_idx = 0;
+    while (true) {
+        if (state.statement) {
+            out_idx = FillOutput(context.client, bind_data, state, output, out_idx);
+            if (out_idx == STANDARD_VECTOR_SIZE) {
+                output.SetCardinality(out_idx);
+                return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+            }
+        }
+        if (state.keys.empty()) {
+            output.SetCardinality(out_idx);
+            return OperatorFinalizeResultType::FINISHED;
+        }
+        ExecuteBatch(context.client, bind_data, state);
+    }
+}
+
+TableFunction OdbcLookupFunction() {
+    TableFunction result("odbc_lookup", {LogicalType::TABLE}, nullptr, BindOdbcLookup, InitOdbcLookupGlobalState,
+                         InitOdbcLookupLocalState);
+    result.in_out_function = OdbcLookupInOut;
+    result.in_out_function_final = OdbcLookupFinal;
+
+    // Add named parameters
+    result.named_parameters["connection"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["table_name"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["key"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["columns"] = LogicalType::LIST(LogicalType::VARCHAR);
+    result.named_parameters["username"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["password"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["all_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["encoding"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["isolation"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["query_timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["fetch_timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["batch_size"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["max_lob_size"] = LogicalType(LogicalTypeId::BIGINT);
+    result.named_parameters["lob_overflow"] = LogicalType(LogicalTypeId::VARCHAR);
+
+    return result;
+}
+
+} // namespace duckdb
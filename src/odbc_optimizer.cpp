@@ -0,0 +1,431 @@
+#include "odbc_optimizer.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_filter_pushdown.hpp"
+#include "odbc_scanner.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/optimizer/column_binding_replacer.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_top_n.hpp"
+
+namespace duckdb {
+
+static bool GetAggregatePushdown(ClientContext &context) {
+    Value value;
+    if (context.TryGetCurrentSetting("odbc_aggregate_pushdown", value) && !value.IsNull()) {
+        return BooleanValue::Get(value);
+    }
+    return true;
+}
+
+// Find the odbc_scan below op, looking through projections (LIMIT and TOP-N commute with them)
+static optional_ptr<LogicalGet> FindOdbcScan(LogicalOperator &op) {
+    reference<LogicalOperator> current = op;
+    while (current.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+        current = *current.get().children[0];
+    }
+    if (current.get().type != LogicalOperatorType::LOGICAL_GET) {
+        return nullptr;
+    }
+    auto &get = current.get().Cast<LogicalGet>();
+    if (get.function.name != "odbc_scan" || !get.bind_data) {
+        return nullptr;
+    }
+    return &get;
+}
+
+// Render the filters of the scan for the data source; returns false if any of them has to be
+// evaluated locally
+static bool GetRemotePredicate(LogicalGet &get, OdbcScannerState &bind_data, std::string &predicate) {
+    if (get.table_filters.filters.empty()) {
+        return true;
+    }
+    
+    vector<column_t> column_ids;
+    vector<LogicalType> types;
+    for (auto &column_index : get.GetColumnIds()) {
+        auto column_id = column_index.GetPrimaryIndex();
+        column_ids.push_back(column_id);
+        types.push_back(column_index.IsRowIdColumn() ? LogicalType(LogicalType::ROW_TYPE) 
+                                                     : bind_data.column_types[column_id]);
+    }
+    unique_ptr<Expression> residual;
+    bool push_filters = bind_data.options.filter_pushdown && !bind_data.options.all_varchar;
+    predicate = OdbcFilterPushdown::TransformFilters(column_ids, types, bind_data.column_names, get.table_filters, 
+                                                     push_filters, residual);
+    return !residual;
+}
+
+// A limit can only be sent if the source evaluates every filter of the scan and
+// knows a row limiting syntax
+static bool CanPushLimit(LogicalGet &get, OdbcScannerState &bind_data) {
+    if (bind_data.table_name.empty() || 
+        OdbcDialect::GetLimitSyntax(bind_data.dbms_name) == OdbcLimitSyntax::NONE) {
+        return false;
+    }
+    std::string predicate;
+    return GetRemotePredicate(get, bind_data, predicate);
+}
+
+static void SetRowLimit(OdbcScannerState &bind_data, idx_t limit) {
+    if (!bind_data.row_limit.IsValid() || limit < bind_data.row_limit.GetIndex()) {
+        bind_data.row_limit = limit;
+    }
+}
+
+// Resolve an order key to a column of the scan; returns false for anything but a plain column reference
+static bool ResolveScanColumn(LogicalOperator &op, const Expression &expr, LogicalGet &get, 
+                              OdbcScannerState &bind_data, std::string &name, LogicalType &type) {
+    if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+        return false;
+    }
+    auto &colref = expr.Cast<BoundColumnRefExpression>();
+    
+    if (op.type == LogicalOperatorType::LOGICAL_PROJECTION) {
+        auto &projection = op.Cast<LogicalProjection>();
+        if (colref.binding.table_index != projection.table_index) {
+            return false;
+        }
+        return ResolveScanColumn(*op.children[0], *projection.expressions[colref.binding.column_index], get,
+                                 bind_data, name, type);
+    }
+    
+    if (&op != &get || colref.binding.table_index != get.table_index) {
+        return false;
+    }
+    auto column_idx = colref.binding.column_index;
+    if (!get.projection_ids.empty()) {
+        column_idx = get.projection_ids[column_idx];
+    }
+    auto &column_index = get.GetColumnIds()[column_idx];
+    if (column_index.IsRowIdColumn()) {
+        return false;
+    }
+    name = bind_data.column_names[column_index.GetPrimaryIndex()];
+    type = bind_data.column_types[column_index.GetPrimaryIndex()];
+    return true;
+}
+
+// Strings are compared with the remote collation, which may not match DuckDB's
+static bool CanOrderRemotely(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::HUGEINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::UBIGINT:
+        case LogicalTypeId::DECIMAL:
+        case LogicalTypeId::FLOAT:
+        case LogicalTypeId::DOUBLE:
+        case LogicalTypeId::DATE:
+        case LogicalTypeId::TIME:
+        case LogicalTypeId::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void TryPushLimit(LogicalLimit &limit) {
+    if (limit.limit_val.Type() != LimitNodeType::CONSTANT_VALUE) {
+        return;
+    }
+    idx_t offset = 0;
+    if (limit.offset_val.Type() == LimitNodeType::CONSTANT_VALUE) {
+        offset = limit.offset_val.GetConstantValue();
+    } else if (limit.offset_val.Type() != LimitNodeType::UNSET) {
+        return;
+    }
+    
+    auto get = FindOdbcScan(*limit.children[0]);
+    if (!get) {
+        return;
+    }
+    auto &bind_data = get->bind_data->Cast<OdbcScannerState>();
+    auto count = limit.limit_val.GetConstantValue();
+    if (count > NumericLimits<idx_t>::Maximum() - offset || !CanPushLimit(*get, bind_data)) {
+        return;
+    }
+    // The offset is still applied locally, so the source returns offset + limit rows
+    SetRowLimit(bind_data, count + offset);
+}
+
+static void TryPushTopN(LogicalTopN &top_n) {
+    auto get = FindOdbcScan(*top_n.children[0]);
+    if (!get) {
+        return;
+    }
+    auto &bind_data = get->bind_data->Cast<OdbcScannerState>();
+    if (top_n.limit > NumericLimits<idx_t>::Maximum() - top_n.offset || !bind_data.order_by.empty() ||
+        !CanPushLimit(*get, bind_data)) {
+        return;
+    }
+    
+    std::vector<std::string> keys;
+    for (auto &order : top_n.orders) {
+        std::string name;
+        LogicalType type;
+        if (!ResolveScanColumn(*top_n.children[0], *order.expression, *get, bind_data, name, type) ||
+            !CanOrderRemotely(type)) {
+            return;
+        }
+        if (order.type != OrderType::ASCENDING && order.type != OrderType::DESCENDING) {
+            return;
+        }
+        if (order.null_order != OrderByNullType::NULLS_FIRST && order.null_order != OrderByNullType::NULLS_LAST) {
+            return;
+        }
+        
+        // NULL placement differs between databases - spell it out portably
+        auto column = "\"" + OdbcUtils::SanitizeString(name) + "\"";
+        bool nulls_first = order.null_order == OrderByNullType::NULLS_FIRST;
+        keys.push_back(StringUtil::Format("CASE WHEN %s IS NULL THEN %d ELSE %d END", column, 
+                                          nulls_first ? 0 : 1, nulls_first ? 1 : 0));
+        keys.push_back(column + (order.type == OrderType::ASCENDING ? " ASC" : " DESC"));
+    }
+    if (keys.empty()) {
+        return;
+    }
+    
+    bind_data.order_by = StringUtil::Join(keys, ", ");
+    SetRowLimit(bind_data, top_n.limit + top_n.offset);
+}
+
+// Grouping by strings or floating point values may form other groups on the data source
+// (collations, -0.0 and NaN)
+static bool CanGroupRemotely(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::FLOAT:
+        case LogicalTypeId::DOUBLE:
+            return false;
+        default:
+            return CanOrderRemotely(type);
+    }
+}
+
+// Integer sums are widened before they are summed remotely - DuckDB sums them as HUGEINT,
+// while e.g. SQL Server sums INT columns as INT and fails beyond 2^31
+static bool IsWidenedSum(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// SUM over exact numbers and doubles; BIGINT sums may exceed what drivers return exactly, and
+// DuckDB sums REAL as DOUBLE while e.g. PostgreSQL's sum(real) stays REAL
+static bool CanSumRemotely(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::DECIMAL:
+        case LogicalTypeId::DOUBLE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Render an aggregate of scan columns for the data source; returns false for functions,
+// arguments and modifiers whose remote result may differ from DuckDB's
+static bool RenderAggregate(LogicalOperator &child, const BoundAggregateExpression &aggregate, LogicalGet &get,
+                            OdbcScannerState &bind_data, std::string &sql) {
+    if (aggregate.IsDistinct() || aggregate.filter || aggregate.order_bys) {
+        return false;
+    }
+    auto &function_name = aggregate.function.name;
+    // 64-bit counts like DuckDB's
+    auto count_function = OdbcDialect::CountFunction(bind_data.dbms_name);
+    if (function_name == "count_star") {
+        sql = count_function + "(*)";
+        return aggregate.children.empty();
+    }
+    if (aggregate.children.size() != 1) {
+        return false;
+    }
+    std::string name;
+    LogicalType type;
+    if (!ResolveScanColumn(child, *aggregate.children[0], get, bind_data, name, type)) {
+        return false;
+    }
+    auto column = "\"" + OdbcUtils::SanitizeString(name) + "\"";
+    if (function_name == "count") {
+        sql = count_function + "(" + column + ")";
+        return true;
+    }
+    if ((function_name == "sum" || function_name == "sum_no_overflow") && CanSumRemotely(type)) {
+        // DECIMAL(38, 0) is the transfer type of the HUGEINT result and castable everywhere
+        // (Oracle has no BIGINT)
+        sql = IsWidenedSum(type) ? "SUM(CAST(" + column + " AS DECIMAL(38, 0)))" : "SUM(" + column + ")";
+        return true;
+    }
+    if ((function_name == "min" || function_name == "max") && CanOrderRemotely(type)) {
+        sql = StringUtil::Upper(function_name) + "(" + column + ")";
+        return true;
+    }
+    return false;
+}
+
+// Type a column of the aggregate query is fetched as. HUGEINT sums arrive as decimal text.
+static LogicalType GetTransferType(const LogicalType &type) {
+    if (type.id() == LogicalTypeId::HUGEINT) {
+        return LogicalType::DECIMAL(Decimal::MAX_WIDTH_INT128, 0);
+    }
+    return type;
+}
+
+// Replace GROUP BY / aggregates over an odbc_scan with an odbc_query that aggregates on the
+// data source, followed by a projection with the aggregate's output types. The bindings of
+// the aggregate's outputs are added to replacements.
+static void TryPushAggregate(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op,
+                             vector<ReplacementBinding> &replacements) {
+    auto &aggregate = op->Cast<LogicalAggregate>();
+    if (aggregate.grouping_sets.size() > 1 || !aggregate.grouping_functions.empty() ||
+        (aggregate.groups.empty() && aggregate.expressions.empty())) {
+        return;
+    }
+    auto &child = *aggregate.children[0];
+    auto get = FindOdbcScan(child);
+    if (!get) {
+        return;
+    }
+    auto &bind_data = get->bind_data->Cast<OdbcScannerState>();
+    if (bind_data.table_name.empty() || bind_data.options.cache || bind_data.row_limit.IsValid() ||
+        OdbcDialect::GetLimitSyntax(bind_data.dbms_name) == OdbcLimitSyntax::NONE) {
+        return;
+    }
+    std::string predicate;
+    if (!GetRemotePredicate(*get, bind_data, predicate)) {
+        return;
+    }
+    
+    std::vector<std::string> select_list;
+    std::vector<std::string> group_list;
+    vector<LogicalType> output_types;
+    for (auto &group : aggregate.groups) {
+        std::string name;
+        LogicalType type;
+        if (!ResolveScanColumn(child, *group, *get, bind_data, name, type) || !CanGroupRemotely(type)) {
+            return;
+        }
+        group_list.push_back("\"" + OdbcUtils::SanitizeString(name) + "\"");
+        select_list.push_back(group_list.back());
+        output_types.push_back(group->return_type);
+    }
+    for (auto &expression : aggregate.expressions) {
+        std::string sql;
+        if (expression->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE ||
+            !RenderAggregate(child, expression->Cast<BoundAggregateExpression>(), *get, bind_data, sql)) {
+            return;
+        }
+        select_list.push_back(sql);
+        output_types.push_back(expression->return_type);
+    }
+    
+    auto query_data = make_uniq<OdbcScannerState>();
+    query_data->connection_params = bind_data.connection_params;
+    query_data->options = bind_data.options;
+    query_data->dbms_name = bind_data.dbms_name;
+    query_data->sql = "SELECT " + StringUtil::Join(select_list, ", ") + " FROM " + QuoteTableName(bind_data);
+    if (!predicate.empty()) {
+        query_data->sql += " WHERE " + predicate;
+    }
+    if (!group_list.empty()) {
+        query_data->sql += " GROUP BY " + StringUtil::Join(group_list, ", ");
+    }
+    for (idx_t i = 0; i < output_types.size(); i++) {
+        query_data->column_names.push_back(select_list[i]);
+        query_data->column_types.push_back(GetTransferType(output_types[i]));
+    }
+    
+    auto get_index = binder.GenerateTableIndex();
+    auto names = query_data->column_names;
+    auto types = query_data->column_types;
+    auto query_get = make_uniq<LogicalGet>(get_index, OdbcQueryFunction(), std::move(query_data), types, names);
+    vector<unique_ptr<Expression>> projections;
+    for (idx_t i = 0; i < types.size(); i++) {
+        query_get->AddColumnId(i);
+        auto column = make_uniq<BoundColumnRefExpression>(types[i], ColumnBinding(get_index, i));
+        projections.push_back(BoundCastExpression::AddCastToType(context, std::move(column), output_types[i]));
+    }
+    
+    auto projection_index = binder.GenerateTableIndex();
+    for (idx_t i = 0; i < aggregate.groups.size(); i++) {
+        replacements.emplace_back(ColumnBinding(aggregate.group_index, i), ColumnBinding(projection_index, i));
+    }
+    for (idx_t i = 0; i < aggregate.expressions.size(); i++) {
+        replacements.emplace_back(ColumnBinding(aggregate.aggregate_index, i),
+                                  ColumnBinding(projection_index, aggregate.groups.size() + i));
+    }
+    auto projection = make_uniq<LogicalProjection>(projection_index, std::move(projections));
+    projection->children.push_back(std::move(query_get));
+    op = std::move(projection);
+}
+
+static void OptimizeOperator(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op,
+                             vector<ReplacementBinding> &replacements) {
+    switch (op->type) {
+        case LogicalOperatorType::LOGICAL_LIMIT:
+            TryPushLimit(op->Cast<LogicalLimit>());
+            break;
+        case LogicalOperatorType::LOGICAL_TOP_N:
+            TryPushTopN(op->Cast<LogicalTopN>());
+            break;
+        case LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY:
+            if (GetAggregatePushdown(input.context)) {
+                TryPushAggregate(input.context, input.optimizer.binder, op, replacements);
+            }
+            break;
+        default:
+            break;
+    }
+    for (auto &child : op->children) {
+        OptimizeOperator(input, child, replacements);
+    }
+}
+
+void OdbcOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+    vector<ReplacementBinding> replacements;
+    OptimizeOperator(input, plan, replacements);
+    if (!replacements.empty()) {
+        // Point the operators above each replaced aggregate to its projection
+        ColumnBindingReplacer replacer;
+        replacer.replacement_bindings = std::move(replacements);
+        replacer.VisitOperator(*plan);
+    }
+}
+
+void OdbcOptimizer::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_aggregate_pushdown",
+                              "Compute COUNT, SUM, MIN and MAX over odbc_scan tables on the data source",
+                              LogicalType::BOOLEAN, Value::BOOLEAN(true));
+}
+
+void OdbcOptimizer::Register(DBConfig &config) {
+    OptimizerExtension extension;
+    extension.optimize_function = Optimize;
+    config.optimizer_extensions.push_back(std::move(extension));
+}
+
+} // namespace duckdb
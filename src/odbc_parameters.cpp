@@ -1,16 +1,17 @@
 #include "odbc_parameters.hpp"
+#include "odbc_encoding.hpp"
 #include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
-ConnectionParams OdbcParameterParser::ParseConnectionParams(const TableFunctionBindInput& input) {
+ConnectionParams OdbcParameterParser::ParseConnectionParams(const TableFunctionBindInput& input, bool default_read_only) {
     std::string connection = GetRequiredString(input, "connection");
     std::string username = GetOptionalString(input, "username");
     std::string password = GetOptionalString(input, "password");
     
     // Parse additional connection options
     int timeout = 60;  // Default timeout
-    bool read_only = true;  // Default to read-only
+    bool read_only = default_read_only;
     
     auto timeout_param = input.named_parameters.find("timeout");
     if (timeout_param != input.named_parameters.end()) {
@@ -22,7 +23,30 @@ ConnectionParams OdbcParameterParser::ParseConnectionParams(const TableFunctionB
         read_only = read_only_param->second.GetValue<bool>();
     }
     
-    return ConnectionParams(connection, username, password, timeout, read_only);
+    auto isolation = ParseIsolationLevel(GetOptionalString(input, "isolation"));
+    
+    return ConnectionParams(connection, username, password, timeout, read_only, isolation);
+}
+
+SQLUINTEGER OdbcParameterParser::ParseIsolationLevel(const std::string& level) {
+    auto lower = StringUtil::Lower(level);
+    if (lower.empty() || lower == "default") {
+        return 0;
+    }
+    if (lower == "read_uncommitted") {
+        return SQL_TXN_READ_UNCOMMITTED;
+    }
+    if (lower == "read_committed") {
+        return SQL_TXN_READ_COMMITTED;
+    }
+    if (lower == "repeatable_read") {
+        return SQL_TXN_REPEATABLE_READ;
+    }
+    if (lower == "serializable") {
+        return SQL_TXN_SERIALIZABLE;
+    }
+    throw BinderException("Parameter 'isolation' must be 'read_uncommitted', 'read_committed', "
+                          "'repeatable_read' or 'serializable', got '%s'", level);
 }
 
 OdbcOptions OdbcParameterParser::ParseCommonOptions(const TableFunctionBindInput& input) {
@@ -30,17 +54,71 @@ OdbcOptions OdbcParameterParser::ParseCommonOptions(const TableFunctionBindInput
     
     options.all_varchar = GetOptionalBoolean(input, "all_varchar", false);
     options.encoding = GetOptionalString(input, "encoding", "UTF-8");
+    OdbcEncoding::VerifyEncoding(options.encoding);
     options.overwrite = GetOptionalBoolean(input, "overwrite", false);
+    options.filter_pushdown = GetOptionalBoolean(input, "filter_pushdown", true);
+    options.cache = GetOptionalBoolean(input, "cache", false);
+    
+    auto batch_size = GetOptionalInteger(input, "batch_size", STANDARD_VECTOR_SIZE);
+    if (batch_size <= 0) {
+        throw BinderException("Parameter 'batch_size' must be greater than zero");
+    }
+    options.batch_size = static_cast<idx_t>(batch_size);
+    options.adaptive_batch_size = input.named_parameters.find("batch_size") == input.named_parameters.end();
+    
+    auto max_lob_size = GetOptionalInteger(input, "max_lob_size", 0);
+    if (max_lob_size < 0) {
+        throw BinderException("Parameter 'max_lob_size' must not be negative");
+    }
+    options.max_lob_size = static_cast<idx_t>(max_lob_size);
+    options.lob_overflow_null = ParseLobOverflow(GetOptionalString(input, "lob_overflow", "truncate"));
+    
+    auto query_timeout = GetOptionalInteger(input, "query_timeout", 0);
+    if (query_timeout < 0) {
+        throw BinderException("Parameter 'query_timeout' must not be negative");
+    }
+    options.query_timeout = static_cast<idx_t>(query_timeout);
+    
+    auto fetch_timeout = GetOptionalInteger(input, "fetch_timeout", 0);
+    if (fetch_timeout < 0) {
+        throw BinderException("Parameter 'fetch_timeout' must not be negative");
+    }
+    options.fetch_timeout = static_cast<idx_t>(fetch_timeout);
     
     return options;
 }
 
+bool OdbcParameterParser::ParseLobOverflow(const std::string& mode) {
+    auto lower = StringUtil::Lower(mode);
+    if (lower == "truncate") {
+        return false;
+    }
+    if (lower == "null") {
+        return true;
+    }
+    throw BinderException("Parameter 'lob_overflow' must be 'truncate' or 'null', got '%s'", mode);
+}
+
 OdbcScanParameters OdbcParameterParser::ParseScanParameters(const TableFunctionBindInput& input) {
     OdbcScanParameters params;
     
     params.connection = ParseConnectionParams(input);
     params.table_name = GetRequiredString(input, "table_name");
     params.options = ParseCommonOptions(input);
+    params.partition_column = GetOptionalString(input, "partition_column");
+    params.snapshot = GetOptionalBoolean(input, "snapshot", false);
+    params.cache_watermark = GetOptionalString(input, "cache_watermark");
+    if (!params.cache_watermark.empty() && !params.options.cache) {
+        throw BinderException("Parameter 'cache_watermark' requires cache = true");
+    }
+    
+    if (input.named_parameters.find("partitions") != input.named_parameters.end()) {
+        auto partitions = GetOptionalInteger(input, "partitions");
+        if (partitions <= 0) {
+            throw BinderException("Parameter 'partitions' must be greater than zero");
+        }
+        params.partitions = static_cast<idx_t>(partitions);
+    }
     
     return params;
 }
@@ -52,6 +130,26 @@ OdbcQueryParameters OdbcParameterParser::ParseQueryParameters(const TableFunctio
     params.query = GetRequiredString(input, "query");
     params.options = ParseCommonOptions(input);
     
+    // A list for values of one type, a struct (row(...)) for mixed types
+    auto params_param = input.named_parameters.find("params");
+    if (params_param != input.named_parameters.end()) {
+        auto &value = params_param->second;
+        if (value.IsNull()) {
+            throw BinderException("Parameter 'params' must not be NULL");
+        }
+        switch (value.type().id()) {
+            case LogicalTypeId::LIST:
+                params.params = ListValue::GetChildren(value);
+                break;
+            case LogicalTypeId::STRUCT:
+                params.params = StructValue::GetChildren(value);
+                break;
+            default:
+                throw BinderException("Parameter 'params' must be a list or a struct of values, got %s",
+                                      value.type().ToString());
+        }
+    }
+    
     return params;
 }
 
@@ -59,8 +157,68 @@ OdbcExecParameters OdbcParameterParser::ParseExecParameters(const TableFunctionB
     OdbcExecParameters params;
     
     params.connection = ParseConnectionParams(input);
-    params.sql = GetRequiredString(input, "sql");
     params.options = ParseCommonOptions(input);
+    params.transaction = GetOptionalBoolean(input, "transaction", false);
+    
+    // One statement or a list of statements
+    auto sql_param = input.named_parameters.find("sql");
+    if (sql_param == input.named_parameters.end()) {
+        throw BinderException("Missing required parameter 'sql'");
+    }
+    auto &value = sql_param->second;
+    if (value.type().id() == LogicalTypeId::VARCHAR && !value.IsNull()) {
+        params.statements.push_back(StringValue::Get(value));
+    } else if (value.type() == LogicalType::LIST(LogicalType::VARCHAR) && !value.IsNull()) {
+        for (auto &statement : ListValue::GetChildren(value)) {
+            if (statement.IsNull()) {
+                throw BinderException("Parameter 'sql' must not contain NULL");
+            }
+            params.statements.push_back(StringValue::Get(statement));
+        }
+    } else {
+        throw BinderException("Parameter 'sql' must be a string or a list of strings");
+    }
+    
+    return params;
+}
+
+OdbcInsertParameters OdbcParameterParser::ParseInsertParameters(const TableFunctionBindInput& input) {
+    OdbcInsertParameters params;
+    
+    // Writing needs a read-write connection unless asked otherwise
+    params.connection = ParseConnectionParams(input, false);
+    params.table_name = GetRequiredString(input, "table_name");
+    params.options = ParseCommonOptions(input);
+    
+    auto commit_interval = GetOptionalInteger(input, "commit_interval", 0);
+    if (commit_interval < 0) {
+        throw BinderException("Parameter 'commit_interval' must not be negative");
+    }
+    params.commit_interval = static_cast<idx_t>(commit_interval);
+    
+    return params;
+}
+
+OdbcLookupParameters OdbcParameterParser::ParseLookupParameters(const TableFunctionBindInput& input) {
+    OdbcLookupParameters params;
+    
+    params.connection = ParseConnectionParams(input);
+    params.table_name = GetRequiredString(input, "table_name");
+    params.key = GetOptionalString(input, "key");
+    params.options = ParseCommonOptions(input);
+    if (input.named_parameters.find("batch_size") == input.named_parameters.end()) {
+        params.options.batch_size = OdbcLookupParameters::DEFAULT_BATCH_SIZE;
+    }
+    
+    auto columns_param = input.named_parameters.find("columns");
+    if (columns_param != input.named_parameters.end() && !columns_param->second.IsNull()) {
+        for (auto &column : ListValue::GetChildren(columns_param->second)) {
+            if (column.IsNull()) {
+                throw BinderException("Parameter 'columns' must not contain NULL");
+            }
+            params.columns.push_back(StringValue::Get(column));
+        }
+    }
     
     return params;
 }
@@ -118,4 +276,23 @@ bool OdbcParameterParser::GetOptionalBoolean(const TableFunctionBindInput& input
     return it->second.GetValue<bool>();
 }
 
+int64_t OdbcParameterParser::GetOptionalInteger(const TableFunctionBindInput& input, 
+                                               const std::string& param_name, 
+                                               int64_t default_value) {
+    auto it = input.named_parameters.find(param_name);
+    if (it == input.named_parameters.end()) {
+        return default_value;
+    }
+    
+    if (it->second.IsNull()) {
+        throw BinderException("Parameter '%s' must not be NULL", param_name);
+    }
+    
+    if (!it->second.type().IsIntegral()) {
+        throw BinderException("Parameter '%s' must be an integer", param_name);
+    }
+    
+    return it->second.GetValue<int64_t>();
+}
+
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "odbc_prefetch.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+namespace duckdb {
+
+void OdbcPrefetcher::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_prefetch_depth",
+                              "Chunks an ODBC scan fetches ahead on a background thread (0 disables prefetching)",
+                              LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_DEPTH));
+}
+
+idx_t OdbcPrefetcher::GetDepth(ClientContext &context) {
+    Value value;
+    if (context.TryGetCurrentSetting("odbc_prefetch_depth", value) && !value.IsNull()) {
+        return value.GetValue<uint64_t>();
+    }
+    return DEFAULT_DEPTH;
+}
+
+OdbcPrefetcher::OdbcPrefetcher(const vector<LogicalType> &types_p, idx_t depth_p, produce_function_t produce_p)
+    : types(types_p), depth(MaxValue<idx_t>(depth_p, 1)), produce(std::move(produce_p)) {
+    thread = std::thread([this]() { Run(); });
+}
+
+OdbcPrefetcher::~OdbcPrefetcher() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopped = true;
+    }
+    not_full.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void OdbcPrefetcher::Run() {
+    try {
+        while (true) {
+            {
+                // Backpressure: wait until the scan has taken a chunk
+                unique_lock<mutex> guard(lock);
+                not_full.wait(guard, [this]() { return stopped || queue.size() < depth; });
+                if (stopped) {
+                    break;
+                }
+            }
+
+            // Fetch and convert outside the lock
+            auto chunk = make_uniq<DataChunk>();
+            chunk->Initialize(Allocator::DefaultAllocator(), types);
+            bool more = produce(*chunk);
+
+            lock_guard<mutex> guard(lock);
+            if (chunk->size() > 0) {
+                queue.push_back(std::move(chunk));
+            }
+            if (!more) {
+                break;
+            }
+            not_empty.notify_one();
+        }
+    } catch (...) {
+        lock_guard<mutex> guard(lock);
+        error = std::current_exception();
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        finished = true;
+    }
+    not_empty.notify_all();
+}
+
+unique_ptr<DataChunk> OdbcPrefetcher::Next() {
+    unique_lock<mutex> guard(lock);
+    not_empty.wait(guard, [this]() { return !queue.empty() || finished; });
+
+    // Chunks fetched before an error are still served in order
+    if (queue.empty()) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return nullptr;
+    }
+
+    auto chunk = std::move(queue.front());
+    queue.pop_front();
+    guard.unlock();
+    not_full.notify_one();
+    return chunk;
+}
+
+} // namespace duckdb
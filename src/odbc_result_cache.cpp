@@ -0,0 +1,98 @@
+#include "odbc_result_cache.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+namespace duckdb {
+
+idx_t OdbcCachedResult::Count() const {
+    idx_t count = 0;
+    for (auto &segment : segments) {
+        count += segment->Count();
+    }
+    return count;
+}
+
+idx_t OdbcCachedResult::SizeInBytes() const {
+    idx_t size = 0;
+    for (auto &segment : segments) {
+        size += segment->SizeInBytes();
+    }
+    return size;
+}
+
+std::shared_ptr<OdbcResultCache> OdbcResultCache::Get(ClientContext &context) {
+    auto cache = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcResultCache>(ObjectType());
+    Value value;
+    if (context.TryGetCurrentSetting("odbc_result_cache_size", value) && !value.IsNull()) {
+        cache->SetMaxSize(DBConfig::ParseMemoryLimit(value.ToString()));
+    }
+    return cache;
+}
+
+// Reject sizes that do not parse when they are set rather than on the next scan
+static void ValidateCacheSize(ClientContext &context, SetScope scope, Value &parameter) {
+    DBConfig::ParseMemoryLimit(parameter.ToString());
+}
+
+void OdbcResultCache::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_result_cache_size",
+                              "Memory kept for ODBC scan results cached with cache = true, e.g. '1GB' "
+                              "(least recently used results are evicted first, 0 disables the cache)",
+                              LogicalType::VARCHAR, Value("256MB"), ValidateCacheSize);
+}
+
+std::shared_ptr<const OdbcCachedResult> OdbcResultCache::Lookup(const std::string &key) {
+    lock_guard<mutex> guard(lock);
+    auto entry = entries.find(key);
+    if (entry == entries.end()) {
+        return nullptr;
+    }
+    recency.splice(recency.begin(), recency, entry->second.position);
+    return entry->second.result;
+}
+
+void OdbcResultCache::Store(const std::string &key, std::shared_ptr<const OdbcCachedResult> result) {
+    auto size = result->SizeInBytes();
+    lock_guard<mutex> guard(lock);
+    auto existing = entries.find(key);
+    if (existing != entries.end()) {
+        Remove(existing);
+    }
+    if (size > max_size) {
+        return;
+    }
+    while (total_size + size > max_size) {
+        Remove(entries.find(recency.back()));
+    }
+    recency.push_front(key);
+    auto &entry = entries[key];
+    entry.result = std::move(result);
+    entry.size = size;
+    entry.position = recency.begin();
+    total_size += size;
+}
+
+void OdbcResultCache::Remove(std::unordered_map<std::string, CachedEntry>::iterator entry) {
+    total_size -= entry->second.size;
+    recency.erase(entry->second.position);
+    entries.erase(entry);
+}
+
+idx_t OdbcResultCache::Clear() {
+    lock_guard<mutex> guard(lock);
+    auto count = entries.size();
+    entries.clear();
+    recency.clear();
+    total_size = 0;
+    return count;
+}
+
+void OdbcResultCache::SetMaxSize(idx_t max_size_p) {
+    lock_guard<mutex> guard(lock);
+    max_size = max_size_p;
+    while (total_size > max_size) {
+        Remove(entries.find(recency.back()));
+    }
+}
+
+} // namespace duckdb
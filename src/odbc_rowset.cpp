@@ -0,0 +1,990 @@
+#include "odbc_rowset.hpp"
+#include "odbc_driver_info.hpp"
+#include "odbc_statement.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/common/operator/decimal_cast_operators.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include <type_traits>
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Column converters
+//------------------------------------------------------------------------------
+
+static void SetValidity(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto indicators = buffer.indicators.get() + offset;
+    auto &validity = FlatVector::Validity(out);
+    for (idx_t i = 0; i < count; i++) {
+        if (indicators[i] == SQL_NULL_DATA) {
+            validity.SetInvalid(out_offset + i);
+        }
+    }
+}
+
+// The C type has the same layout as the DuckDB physical type - copy the column as a block
+template <class T>
+static void ConvertFixed(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const T *>(buffer.data.get()) + offset;
+    memcpy(FlatVector::GetData<T>(out) + out_offset, source, count * sizeof(T));
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+static void ConvertBoolean(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const unsigned char *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<bool>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        target[i] = source[i] != 0;
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+// Layout of SQL_C_SS_TIME2 and SQL_C_SS_TIMESTAMPOFFSET values (msodbcsql.h)
+struct OdbcTime2Struct {
+    SQLUSMALLINT hour;
+    SQLUSMALLINT minute;
+    SQLUSMALLINT second;
+    SQLUINTEGER fraction;
+};
+
+struct OdbcTimestampOffsetStruct {
+    SQLSMALLINT year;
+    SQLUSMALLINT month;
+    SQLUSMALLINT day;
+    SQLUSMALLINT hour;
+    SQLUSMALLINT minute;
+    SQLUSMALLINT second;
+    SQLUINTEGER fraction;
+    SQLSMALLINT timezone_hour;
+    SQLSMALLINT timezone_minute;
+};
+
+// Date and time structs are converted field by field into DuckDB's day and microsecond
+// counts. Fractions are nanoseconds in all of them.
+static void ConvertDate(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const SQL_DATE_STRUCT *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<date_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] != SQL_NULL_DATA) {
+            target[i] = Date::FromDate(source[i].year, source[i].month, source[i].day);
+        }
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+static void ConvertTime(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const SQL_TIME_STRUCT *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<dtime_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] != SQL_NULL_DATA) {
+            target[i] = Time::FromTime(source[i].hour, source[i].minute, source[i].second, 0);
+        }
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+static void ConvertTime2(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const OdbcTime2Struct *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<dtime_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] != SQL_NULL_DATA) {
+            target[i] = Time::FromTime(source[i].hour, source[i].minute, source[i].second,
+                                       static_cast<int32_t>(source[i].fraction / 1000));
+        }
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+// TIME columns with fractional seconds of drivers without a TIME struct that holds them
+static void ConvertTimeText(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count,
+                            idx_t out_offset) {
+    auto target = FlatVector::GetData<dtime_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        auto row = offset + i;
+        auto length = buffer.indicators[row];
+        if (length == SQL_NULL_DATA) {
+            continue;
+        }
+        auto text = const_char_ptr_cast(buffer.data.get() + row * buffer.value_width);
+        target[i] = Time::FromCString(text, strlen(text));
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+static void ConvertTimestamp(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count,
+                             idx_t out_offset) {
+    auto source = reinterpret_cast<const SQL_TIMESTAMP_STRUCT *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<timestamp_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] != SQL_NULL_DATA) {
+            auto &value = source[i];
+            target[i] = Timestamp::FromDatetime(Date::FromDate(value.year, value.month, value.day),
+                                                Time::FromTime(value.hour, value.minute, value.second,
+                                                               static_cast<int32_t>(value.fraction / 1000)));
+        }
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+// Local time and UTC offset, stored as the UTC instant
+static void ConvertTimestampOffset(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count,
+                                   idx_t out_offset) {
+    auto source = reinterpret_cast<const OdbcTimestampOffsetStruct *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<timestamp_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] != SQL_NULL_DATA) {
+            auto &value = source[i];
+            auto local = Timestamp::FromDatetime(Date::FromDate(value.year, value.month, value.day),
+                                                 Time::FromTime(value.hour, value.minute, value.second,
+                                                                static_cast<int32_t>(value.fraction / 1000)));
+            // Both offset fields carry the sign of the offset
+            int64_t offset_minutes = value.timezone_hour * 60 + value.timezone_minute;
+            target[i] = timestamp_t(local.value - offset_minutes * Interval::MICROS_PER_MINUTE);
+        }
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+// SQLGUID fields are native integers; DuckDB keeps the 128 bits big-endian with the top bit
+// flipped so that UUIDs sort like their text form
+static void ConvertGuid(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto source = reinterpret_cast<const SQLGUID *>(buffer.data.get()) + offset;
+    auto target = FlatVector::GetData<hugeint_t>(out) + out_offset;
+    for (idx_t i = 0; i < count; i++) {
+        if (buffer.indicators[offset + i] == SQL_NULL_DATA) {
+            continue;
+        }
+        auto &value = source[i];
+        uint64_t upper = (static_cast<uint64_t>(value.Data1) << 32) | (static_cast<uint64_t>(value.Data2) << 16) |
+                         static_cast<uint64_t>(value.Data3);
+        uint64_t lower = 0;
+        for (idx_t b = 0; b < 8; b++) {
+            lower = (lower << 8) | value.Data4[b];
+        }
+        target[i].upper = static_cast<int64_t>(upper ^ (static_cast<uint64_t>(1) << 63));
+        target[i].lower = lower;
+    }
+    SetValidity(buffer, out, offset, count, out_offset);
+}
+
+// Length of a value cut to at most max_size bytes. UTF-8 character data is cut
+// before the first character that does not fit completely.
+static idx_t CutLength(const OdbcColumnBuffer &column, const char *data, idx_t max_size) {
+    if (column.c_type != SQL_C_CHAR || column.encoding) {
+        return max_size;
+    }
+    for (idx_t back = 1; back <= MinValue<idx_t>(max_size, 4); back++) {
+        auto byte = static_cast<unsigned char>(data[max_size - back]);
+        if ((byte & 0xC0) == 0x80) {
+            // Continuation byte - keep looking for the lead byte
+            continue;
+        }
+        idx_t width = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+        return back >= width ? max_size : max_size - back;
+    }
+    return max_size;
+}
+
+// Character and binary values: short values are stored inline in the string_t,
+// longer ones are copied once from the bound buffer into the vector's string heap
+static void ConvertString(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto target = FlatVector::GetData<string_t>(out) + out_offset;
+    auto &validity = FlatVector::Validity(out);
+    const SQLLEN max_length = static_cast<SQLLEN>(buffer.value_width) - (buffer.c_type == SQL_C_CHAR ? 1 : 0);
+    
+    for (idx_t i = 0; i < count; i++) {
+        auto row = offset + i;
+        auto length = buffer.indicators[row];
+        if (length == SQL_NULL_DATA) {
+            validity.SetInvalid(out_offset + i);
+            continue;
+        }
+        // Truncated values are clamped here and re-read by the rowset afterwards
+        bool truncated = length == SQL_NO_TOTAL || length > max_length;
+        if (truncated) {
+            length = max_length;
+        }
+        auto value = const_char_ptr_cast(buffer.data.get() + row * buffer.value_width);
+        // Truncated values may end within a character, they are checked when re-read
+        bool reread = truncated;
+        // Values known to be over the LOB limit are cut here; a truncated value only
+        // is if the limit fits into the buffer, otherwise the re-read applies it
+        if (buffer.max_lob_size && (static_cast<idx_t>(length) > buffer.max_lob_size ||
+                                    (truncated && static_cast<idx_t>(max_length) >= buffer.max_lob_size))) {
+            if (buffer.lob_overflow_null) {
+                validity.SetInvalid(out_offset + i);
+                continue;
+            }
+            length = static_cast<SQLLEN>(CutLength(buffer, value, buffer.max_lob_size));
+            reread = false;
+        }
+        if (buffer.encoding) {
+            // ASCII values are taken as is, the rest is transcoded
+            target[i] = buffer.encoding->ConvertToVector(out, value, static_cast<idx_t>(length));
+            continue;
+        }
+        if (buffer.c_type == SQL_C_CHAR && !reread) {
+            OdbcEncoding::VerifyUtf8(value, static_cast<idx_t>(length));
+        }
+        if (static_cast<idx_t>(length) <= string_t::INLINE_LENGTH) {
+            target[i] = string_t(value, static_cast<uint32_t>(length));
+        } else {
+            target[i] = StringVector::AddStringOrBlob(out, value, static_cast<idx_t>(length));
+        }
+    }
+}
+
+// Wide character values are transcoded from the bound UTF-16 buffer straight into the
+// vector, whole characters up to the LOB limit. Truncated values are left to the re-read.
+static void ConvertWideString(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count,
+                              idx_t out_offset) {
+    auto target = FlatVector::GetData<string_t>(out) + out_offset;
+    auto &validity = FlatVector::Validity(out);
+    const SQLLEN max_length = static_cast<SQLLEN>(buffer.value_width - sizeof(SQLWCHAR));
+    
+    for (idx_t i = 0; i < count; i++) {
+        auto row = offset + i;
+        auto length = buffer.indicators[row];
+        if (length == SQL_NULL_DATA) {
+            validity.SetInvalid(out_offset + i);
+            continue;
+        }
+        if (length == SQL_NO_TOTAL || length > max_length) {
+            continue;
+        }
+        auto value = reinterpret_cast<const odbc_wide_unit_t *>(buffer.data.get() + row * buffer.value_width);
+        bool over_limit;
+        target[i] = OdbcEncoding::WideToVector(out, value, static_cast<idx_t>(length) / sizeof(SQLWCHAR),
+                                               buffer.max_lob_size, over_limit);
+        if (over_limit && buffer.lob_overflow_null) {
+            validity.SetInvalid(out_offset + i);
+        }
+    }
+}
+
+static bool IsStringTruncated(const OdbcColumnBuffer &buffer, idx_t row) {
+    auto length = buffer.indicators[row];
+    if (length == SQL_NULL_DATA) {
+        return false;
+    }
+    if (buffer.wide) {
+        const SQLLEN max_length = static_cast<SQLLEN>(buffer.value_width - sizeof(SQLWCHAR));
+        return length == SQL_NO_TOTAL || length > max_length;
+    }
+    const SQLLEN max_length = static_cast<SQLLEN>(buffer.value_width) - (buffer.c_type == SQL_C_CHAR ? 1 : 0);
+    if (buffer.max_lob_size && buffer.max_lob_size <= static_cast<idx_t>(max_length)) {
+        // Cut by ConvertString already
+        return false;
+    }
+    return length == SQL_NO_TOTAL || length > max_length;
+}
+
+// Read a character or binary value of the current row with SQLGetData. When the
+// driver reports the total length up front the value is read straight into string
+// heap memory of the vector; otherwise the chunks are collected in the column's
+// reusable scratch buffer, in chunks that grow with the value. Reading stops at the
+// column's LOB limit. Returns false for NULL (and for values over the limit if they
+// are to become NULL).
+static bool ReadLongValue(SQLHSTMT hstmt, SQLUSMALLINT column_number, OdbcColumnBuffer &column, 
+                          Vector &out, string_t &result) {
+    static constexpr idx_t CHUNK_SIZE = 8192;
+    const idx_t terminator = column.c_type == SQL_C_CHAR ? 1 : 0;
+    const idx_t limit = column.max_lob_size ? column.max_lob_size : NumericLimits<idx_t>::Maximum();
+    auto &scratch = column.long_buffer;
+    if (scratch.size() < CHUNK_SIZE + terminator) {
+        scratch.resize(CHUNK_SIZE + terminator);
+    }
+    
+    SQLLEN indicator = 0;
+    SQLRETURN rc = SQLGetData(hstmt, column_number, column.c_type, scratch.data(), 
+                              static_cast<SQLLEN>(CHUNK_SIZE + terminator), &indicator);
+    if (rc == SQL_NO_DATA) {
+        result = string_t();
+        return true;
+    }
+    if (!SQL_SUCCEEDED(rc)) {
+        OdbcUtils::ThrowException("get long data", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+    }
+    if (indicator == SQL_NULL_DATA) {
+        return false;
+    }
+    
+    bool complete = rc == SQL_SUCCESS || (indicator != SQL_NO_TOTAL && static_cast<idx_t>(indicator) <= CHUNK_SIZE);
+    if (complete) {
+        auto length = static_cast<idx_t>(indicator);
+        if (length > limit) {
+            if (column.lob_overflow_null) {
+                return false;
+            }
+            length = CutLength(column, scratch.data(), limit);
+        }
+        result = StringVector::AddStringOrBlob(out, scratch.data(), length);
+        return true;
+    }
+    
+    if (indicator != SQL_NO_TOTAL) {
+        // Total length is known - read the remaining chunks directly into the heap
+        idx_t total = static_cast<idx_t>(indicator);
+        if (total > limit && column.lob_overflow_null) {
+            // The rest of the value is discarded by the next SQLGetData call or fetch
+            return false;
+        }
+        idx_t wanted = MinValue<idx_t>(total, limit);
+        if (wanted <= CHUNK_SIZE) {
+            result = StringVector::AddStringOrBlob(out, scratch.data(), CutLength(column, scratch.data(), wanted));
+            return true;
+        }
+        result = StringVector::EmptyString(out, wanted);
+        auto target = result.GetDataWriteable();
+        memcpy(target, scratch.data(), CHUNK_SIZE);
+        idx_t received = CHUNK_SIZE;
+        
+        while (received < wanted) {
+            idx_t remaining = wanted - received;
+            if (terminator && remaining == 1) {
+                // A character buffer always receives a terminator - fetch the last byte via scratch
+                rc = SQLGetData(hstmt, column_number, column.c_type, scratch.data(), 2, &indicator);
+                if (rc == SQL_NO_DATA) {
+                    break;
+                }
+                if (!SQL_SUCCEEDED(rc)) {
+                    OdbcUtils::ThrowException("get long data", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+                }
+                target[received++] = scratch[0];
+                break;
+            }
+            
+            rc = SQLGetData(hstmt, column_number, column.c_type, target + received, 
+                            static_cast<SQLLEN>(remaining), &indicator);
+            if (rc == SQL_NO_DATA) {
+                break;
+            }
+            if (!SQL_SUCCEEDED(rc)) {
+                OdbcUtils::ThrowException("get long data", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+            }
+            if (rc == SQL_SUCCESS) {
+                received += MinValue<idx_t>(static_cast<idx_t>(indicator), remaining);
+                break;
+            }
+            received += remaining - terminator;
+        }
+        
+        if (received < wanted) {
+            // The driver returned less than it announced
+            result = string_t(target, static_cast<uint32_t>(received));
+        } else if (wanted < total) {
+            result = string_t(target, static_cast<uint32_t>(CutLength(column, target, wanted)));
+        }
+        result.Finalize();
+        return true;
+    }
+    
+    // Unknown total length - collect the chunks, then copy once into the heap
+    idx_t length = CHUNK_SIZE;
+    bool overflow = false;
+    while (true) {
+        if (length >= limit) {
+            // More data is pending, so the value is over the limit
+            overflow = true;
+            break;
+        }
+        idx_t chunk = MinValue<idx_t>(MaxValue<idx_t>(CHUNK_SIZE, length), limit - length);
+        scratch.resize(length + chunk + terminator);
+        rc = SQLGetData(hstmt, column_number, column.c_type, scratch.data() + length, 
+                        static_cast<SQLLEN>(chunk + terminator), &indicator);
+        if (rc == SQL_NO_DATA) {
+            break;
+        }
+        if (!SQL_SUCCEEDED(rc)) {
+            OdbcUtils::ThrowException("get long data", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+        }
+        if (rc == SQL_SUCCESS || (indicator != SQL_NO_TOTAL && static_cast<idx_t>(indicator) <= chunk)) {
+            length += static_cast<idx_t>(indicator);
+            break;
+        }
+        length += chunk;
+    }
+    if (overflow || length > limit) {
+        if (column.lob_overflow_null) {
+            return false;
+        }
+        length = CutLength(column, scratch.data(), MinValue<idx_t>(length, limit));
+    }
+    result = StringVector::AddStringOrBlob(out, scratch.data(), length);
+    return true;
+}
+
+// DECIMAL values are fetched in their text form and parsed straight into the
+// physical storage with the column's scale - no rounding through double
+template <class T>
+static void ConvertDecimal(const OdbcColumnBuffer &buffer, Vector &out, idx_t offset, idx_t count, idx_t out_offset) {
+    auto target = FlatVector::GetData<T>(out) + out_offset;
+    auto &validity = FlatVector::Validity(out);
+    const SQLLEN max_length = static_cast<SQLLEN>(buffer.value_width) - 1;
+    CastParameters parameters;
+    
+    for (idx_t i = 0; i < count; i++) {
+        auto row = offset + i;
+        auto length = buffer.indicators[row];
+        if (length == SQL_NULL_DATA) {
+            validity.SetInvalid(out_offset + i);
+            continue;
+        }
+        if (length == SQL_NO_TOTAL || length > max_length) {
+            length = max_length;
+        }
+        auto text = const_char_ptr_cast(buffer.data.get() + row * buffer.value_width);
+        string_t value(text, static_cast<uint32_t>(length));
+        if (!TryCastToDecimal::Operation<string_t, T>(value, target[i], parameters, buffer.decimal_width, 
+                                                      buffer.decimal_scale)) {
+            throw InvalidInputException("Could not convert \"%s\" to DECIMAL(%d,%d)", value.GetString(), 
+                                        (int)buffer.decimal_width, (int)buffer.decimal_scale);
+        }
+    }
+}
+
+// Transcode a complete long value if the column has a source encoding, otherwise check
+// that character data is valid UTF-8
+static string_t ConvertLongValue(OdbcColumnBuffer &column, Vector &out, string_t value) {
+    if (!column.encoding) {
+        if (column.c_type == SQL_C_CHAR) {
+            OdbcEncoding::VerifyUtf8(value.GetData(), value.GetSize());
+        }
+        return value;
+    }
+    if (OdbcEncoding::IsAscii(value.GetData(), value.GetSize())) {
+        return value;
+    }
+    return column.encoding->ConvertToVector(out, value.GetData(), value.GetSize());
+}
+
+template <class T>
+static void SetFixed(OdbcColumnBuffer &buffer, SQLSMALLINT c_type) {
+    buffer.c_type = c_type;
+    buffer.value_width = sizeof(T);
+    buffer.convert = ConvertFixed<T>;
+}
+
+// Pick the C type the driver converts into and the converter that copies it
+// into the vector. Returns false if the type has no bound-buffer path.
+static bool ResolveConverter(const LogicalType &type, OdbcColumnBuffer &buffer) {
+    switch (type.id()) {
+        case LogicalTypeId::BOOLEAN:
+            buffer.c_type = SQL_C_BIT;
+            buffer.value_width = sizeof(unsigned char);
+            buffer.convert = ConvertBoolean;
+            return true;
+        case LogicalTypeId::TINYINT:
+            SetFixed<int8_t>(buffer, SQL_C_STINYINT);
+            return true;
+        case LogicalTypeId::SMALLINT:
+            SetFixed<int16_t>(buffer, SQL_C_SSHORT);
+            return true;
+        case LogicalTypeId::INTEGER:
+            SetFixed<int32_t>(buffer, SQL_C_SLONG);
+            return true;
+        case LogicalTypeId::BIGINT:
+            SetFixed<int64_t>(buffer, SQL_C_SBIGINT);
+            return true;
+        case LogicalTypeId::FLOAT:
+            SetFixed<float>(buffer, SQL_C_FLOAT);
+            return true;
+        case LogicalTypeId::DOUBLE:
+            SetFixed<double>(buffer, SQL_C_DOUBLE);
+            return true;
+        case LogicalTypeId::DECIMAL: {
+            // Sign, 38 digits, decimal point and terminator fit with room for drivers that pad
+            buffer.c_type = SQL_C_CHAR;
+            buffer.value_width = 64;
+            buffer.decimal_width = DecimalType::GetWidth(type);
+            buffer.decimal_scale = DecimalType::GetScale(type);
+            switch (type.InternalType()) {
+                case PhysicalType::INT16:
+                    buffer.convert = ConvertDecimal<int16_t>;
+                    return true;
+                case PhysicalType::INT32:
+                    buffer.convert = ConvertDecimal<int32_t>;
+                    return true;
+                case PhysicalType::INT64:
+                    buffer.convert = ConvertDecimal<int64_t>;
+                    return true;
+                case PhysicalType::INT128:
+                    buffer.convert = ConvertDecimal<hugeint_t>;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+        case LogicalTypeId::DATE:
+            buffer.c_type = SQL_C_TYPE_DATE;
+            buffer.value_width = sizeof(SQL_DATE_STRUCT);
+            buffer.convert = ConvertDate;
+            return true;
+        case LogicalTypeId::TIME:
+            // Refined by DescribeColumns
+            buffer.c_type = SQL_C_TYPE_TIME;
+            buffer.value_width = sizeof(SQL_TIME_STRUCT);
+            buffer.convert = ConvertTime;
+            buffer.time = true;
+            return true;
+        case LogicalTypeId::TIMESTAMP:
+            buffer.c_type = SQL_C_TYPE_TIMESTAMP;
+            buffer.value_width = sizeof(SQL_TIMESTAMP_STRUCT);
+            buffer.convert = ConvertTimestamp;
+            return true;
+        case LogicalTypeId::TIMESTAMP_TZ:
+            // Only read from columns described as SQL_SS_TIMESTAMPOFFSET
+            buffer.c_type = SQL_C_SS_TIMESTAMPOFFSET;
+            buffer.value_width = sizeof(OdbcTimestampOffsetStruct);
+            buffer.convert = ConvertTimestampOffset;
+            return true;
+        case LogicalTypeId::UUID:
+            buffer.c_type = SQL_C_GUID;
+            buffer.value_width = sizeof(SQLGUID);
+            buffer.convert = ConvertGuid;
+            return true;
+        case LogicalTypeId::VARCHAR:
+            buffer.c_type = SQL_C_CHAR;
+            buffer.variable_width = true;
+            buffer.convert = ConvertString;
+            return true;
+        case LogicalTypeId::BLOB:
+            buffer.c_type = SQL_C_BINARY;
+            buffer.variable_width = true;
+            buffer.convert = ConvertString;
+            return true;
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// OdbcRowset implementation
+//------------------------------------------------------------------------------
+
+OdbcRowset::OdbcRowset(const vector<LogicalType> &types, idx_t rowset_size_p, const std::string &encoding,
+                       idx_t max_lob_size, bool lob_overflow_null)
+    : requested_rowset_size(MaxValue<idx_t>(rowset_size_p, 1)), rowset_size(requested_rowset_size),
+      max_rowset_size(requested_rowset_size) {
+    // One converter per rowset, i.e. per scan thread
+    if (OdbcEncoding::NeedsConversion(encoding)) {
+        encoding_converter = make_uniq<OdbcEncodingConverter>(encoding);
+    }
+    
+    columns.resize(types.size());
+    for (idx_t i = 0; i < types.size(); i++) {
+        auto &column = columns[i];
+        if (!ResolveConverter(types[i], column)) {
+            throw InternalException("No bound fetch converter for type %s", types[i].ToString());
+        }
+        if (types[i].id() == LogicalTypeId::VARCHAR) {
+            column.encoding = encoding_converter.get();
+        }
+        column.max_lob_size = max_lob_size;
+        column.lob_overflow_null = lob_overflow_null;
+    }
+}
+
+OdbcRowset::~OdbcRowset() {
+    try {
+        Unbind();
+    } catch (...) {
+        // Ignore exceptions during cleanup
+    }
+}
+
+bool OdbcRowset::Supports(const vector<LogicalType> &types) {
+    for (auto &type : types) {
+        OdbcColumnBuffer buffer;
+        if (!ResolveConverter(type, buffer)) {
+            return false;
+        }
+    }
+    return !types.empty();
+}
+
+void OdbcRowset::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_fetch_buffer_mb",
+                              "Memory in MB the bound fetch buffers of one ODBC scan thread may use (0 = no limit)",
+                              LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_BUFFER_MB));
+}
+
+idx_t OdbcRowset::GetBufferBudget(ClientContext &context) {
+    Value value;
+    if (context.TryGetCurrentSetting("odbc_fetch_buffer_mb", value) && !value.IsNull()) {
+        return value.GetValue<uint64_t>() * 1024 * 1024;
+    }
+    return DEFAULT_BUFFER_MB * 1024 * 1024;
+}
+
+void OdbcRowset::SetBufferBudget(idx_t budget, bool adaptive_p) {
+    buffer_budget = budget;
+    adaptive = adaptive_p;
+}
+
+void OdbcRowset::DescribeColumns(SQLHSTMT handle, const OdbcDriverInfo &driver) {
+    SQLSMALLINT result_columns = 0;
+    if (!SQL_SUCCEEDED(SQLNumResultCols(handle, &result_columns))) {
+        OdbcUtils::ThrowException("describe result", nanodbc::database_error(handle, SQL_HANDLE_STMT));
+    }
+    if (static_cast<idx_t>(result_columns) != columns.size()) {
+        throw InvalidInputException("ODBC result has %d columns, expected %d", (int)result_columns, 
+                                    (int)columns.size());
+    }
+    
+    bool has_unbound = false;
+    rowset_size = requested_rowset_size;
+    getdata_bound = driver.getdata_bound;
+    getdata_block = driver.getdata_block;
+    for (idx_t i = 0; i < columns.size(); i++) {
+        auto &column = columns[i];
+        
+        // Once a column is read with SQLGetData, all following columns must be as well,
+        // unless the driver allows SQLGetData before the last bound column
+        column.bound = !has_unbound || driver.getdata_any_column;
+        if (!column.variable_width && !column.time) {
+            continue;
+        }
+        
+        SQLSMALLINT sql_type = 0, digits = 0, nullable = 0;
+        SQLULEN column_size = 0;
+        if (!SQL_SUCCEEDED(SQLDescribeCol(handle, static_cast<SQLUSMALLINT>(i + 1), nullptr, 0, nullptr, 
+                                          &sql_type, &column_size, &digits, &nullable))) {
+            OdbcUtils::ThrowException("describe result column", nanodbc::database_error(handle, SQL_HANDLE_STMT));
+        }
+        
+        // SQL Server's TIME(n) has its own struct with fractions; elsewhere fractional
+        // seconds (decimal digits) are only kept by the text form
+        if (column.time) {
+            if (sql_type == SQL_SS_TIME2) {
+                column.c_type = SQL_C_SS_TIME2;
+                column.value_width = sizeof(OdbcTime2Struct);
+                column.convert = ConvertTime2;
+            } else if (digits > 0) {
+                column.c_type = SQL_C_CHAR;
+                column.value_width = 32;
+                column.convert = ConvertTimeText;
+            } else {
+                column.c_type = SQL_C_TYPE_TIME;
+                column.value_width = sizeof(SQL_TIME_STRUCT);
+                column.convert = ConvertTime;
+            }
+            continue;
+        }
+        
+        column.wide = false;
+        column.convert = ConvertString;
+        bool long_data = column_size == 0 || column_size > MAX_BOUND_STRING_BYTES ||
+                         sql_type == SQL_LONGVARCHAR || sql_type == SQL_WLONGVARCHAR || 
+                         sql_type == SQL_LONGVARBINARY;
+        if (long_data) {
+            column.bound = false;
+            has_unbound = true;
+            continue;
+        }
+        
+        // Wide character data is fetched as the driver's UTF-16 and transcoded by us,
+        // instead of letting the driver manager convert it to narrow characters
+        if (column.c_type == SQL_C_CHAR && (sql_type == SQL_WCHAR || sql_type == SQL_WVARCHAR)) {
+            column.wide = true;
+            column.convert = ConvertWideString;
+            // One code unit per character (the column size counts UTF-16 units) and the terminator
+            column.value_width = (MaxValue<idx_t>(column_size, 32) + 1) * sizeof(SQLWCHAR);
+            continue;
+        }
+        
+        // Leave room for multi-byte characters and the terminator of character data
+        idx_t width = column.c_type == SQL_C_CHAR ? column_size * 4 + 1 : column_size;
+        column.value_width = MinValue<idx_t>(MaxValue<idx_t>(width, 64), MAX_BOUND_STRING_BYTES + 1);
+    }
+    
+    // As many rows of the described width as the budget allows, up to the requested size
+    // (adaptive rowsets start smaller and grow towards the limit while fetching)
+    idx_t row_bytes = 0;
+    for (auto &column : columns) {
+        if (column.bound) {
+            row_bytes += column.value_width + sizeof(SQLLEN);
+        }
+    }
+    max_rowset_size = adaptive ? MAX_ADAPTIVE_ROWSET_SIZE : requested_rowset_size;
+    if (buffer_budget > 0 && row_bytes > 0) {
+        max_rowset_size = MinValue<idx_t>(max_rowset_size, MaxValue<idx_t>(buffer_budget / row_bytes, 1));
+    }
+    
+    // Long data is fetched one row at a time, unless the driver can position its block cursor
+    // on each row for SQLGetData
+    max_rowset_size = driver.LimitRowsetSize(max_rowset_size);
+    if (has_unbound && !driver.getdata_block) {
+        max_rowset_size = 1;
+    }
+    rowset_size = adaptive ? MinValue<idx_t>(adaptive_size, max_rowset_size) : max_rowset_size;
+    Reserve(rowset_size);
+}
+
+bool OdbcRowset::Reserve(idx_t rows) {
+    // Buffers are kept across partitions and rowsets and only grow. Unbound fixed-width
+    // columns use the first slot, so every column has room for at least one row.
+    bool moved = false;
+    for (auto &column : columns) {
+        if (allocated_rows < rows) {
+            column.indicators = make_unsafe_uniq_array<SQLLEN>(rows);
+            moved = true;
+        }
+        idx_t required = rows * column.value_width;
+        if (column.allocated_bytes < required) {
+            column.data = make_unsafe_uniq_array<data_t>(required);
+            column.allocated_bytes = required;
+            moved = true;
+        }
+    }
+    allocated_rows = MaxValue<idx_t>(allocated_rows, rows);
+    return moved;
+}
+
+void OdbcRowset::Bind(OdbcStatement &statement, const OdbcDriverInfo &driver) {
+    Unbind();
+    auto handle = statement.GetNativeHandle();
+    DescribeColumns(handle, driver);
+
+    SQLRETURN rc = SQLSetStmtAttr(handle, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLSetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(uintptr_t)rowset_size, 0);
+    }
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLSetStmtAttr(handle, SQL_ATTR_ROWS_FETCHED_PTR, &rows_fetched, 0);
+    }
+    if (!SQL_SUCCEEDED(rc)) {
+        OdbcUtils::ThrowException("set rowset attributes", nanodbc::database_error(handle, SQL_HANDLE_STMT));
+    }
+
+    // A driver may lower the rowset size (01S02) - keep whatever it settled on
+    SQLULEN actual_size = rowset_size;
+    if (SQL_SUCCEEDED(SQLGetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, &actual_size, 0, nullptr)) &&
+        actual_size > 0 && actual_size < rowset_size) {
+        rowset_size = actual_size;
+        max_rowset_size = actual_size;
+    }
+
+    hstmt = handle;
+    last_rows = 0;
+    last_fetch_ns = 0;
+    BindColumns();
+}
+
+void OdbcRowset::BindColumns() {
+    for (idx_t i = 0; i < columns.size(); i++) {
+        auto &column = columns[i];
+        if (!column.bound) {
+            continue;
+        }
+        SQLRETURN rc = SQLBindCol(hstmt, static_cast<SQLUSMALLINT>(i + 1), column.wide ? SQL_C_WCHAR : column.c_type,
+                                  column.data.get(), static_cast<SQLLEN>(column.value_width), column.indicators.get());
+        if (!SQL_SUCCEEDED(rc)) {
+            OdbcUtils::ThrowException("bind result column " + std::to_string(i + 1),
+                                      nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+        }
+    }
+}
+
+void OdbcRowset::SetRowArraySize(idx_t size) {
+    // Bindings and the row array size may change between fetches; the previous rowset has
+    // been converted by now, so moving the buffers is safe
+    if (Reserve(size)) {
+        BindColumns();
+    }
+    if (!SQL_SUCCEEDED(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(uintptr_t)size, 0))) {
+        // Keep the current size for the rest of the result
+        max_rowset_size = rowset_size;
+        return;
+    }
+    SQLULEN actual_size = size;
+    if (SQL_SUCCEEDED(SQLGetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &actual_size, 0, nullptr)) &&
+        actual_size > 0 && actual_size < size) {
+        size = actual_size;
+        max_rowset_size = actual_size;
+    }
+    rowset_size = size;
+}
+
+void OdbcRowset::Adapt(idx_t rows, uint64_t fetch_ns) {
+    idx_t size = rowset_size;
+    if (rows == rowset_size && fetch_ns < TARGET_FETCH_NS && rowset_size < max_rowset_size) {
+        // Round trips dominate - fetch more rows per trip
+        size = MinValue<idx_t>(rowset_size * 2, max_rowset_size);
+    } else if (fetch_ns > 4 * TARGET_FETCH_NS && rowset_size > MIN_ADAPTIVE_ROWSET_SIZE) {
+        // Waiting this long for one rowset stalls the pipeline - return rows sooner
+        size = MaxValue<idx_t>(rowset_size / 2, MIN_ADAPTIVE_ROWSET_SIZE);
+    }
+    if (size != rowset_size) {
+        SetRowArraySize(size);
+        adaptive_size = rowset_size;
+    }
+}
+
+void OdbcRowset::Unbind() {
+    if (!hstmt) {
+        return;
+    }
+    auto handle = hstmt;
+    hstmt = nullptr;
+    SQLFreeStmt(handle, SQL_UNBIND);
+    SQLSetStmtAttr(handle, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+    SQLSetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+}
+
+idx_t OdbcRowset::Fetch() {
+    if (!hstmt) {
+        throw InternalException("OdbcRowset::Fetch called before Bind");
+    }
+
+    // Resize from the previous fetch, whose rows have been converted by now
+    if (adaptive && last_rows > 0) {
+        Adapt(last_rows, last_fetch_ns);
+    }
+
+    rows_fetched = 0;
+    OdbcScanTimer timer;
+    SQLRETURN rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+    if (rc == SQL_NO_DATA) {
+        return 0;
+    }
+    if (!SQL_SUCCEEDED(rc)) {
+        OdbcUtils::ThrowException("fetch rowset", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+    }
+    last_rows = static_cast<idx_t>(rows_fetched);
+    last_fetch_ns = timer.ElapsedNanos();
+    return last_rows;
+}
+
+void OdbcRowset::ReadUnbound(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset) {
+    auto &column = columns[col_idx];
+    auto column_number = static_cast<SQLUSMALLINT>(col_idx + 1);
+    
+    // Select the row of a block cursor (only used when the driver reports SQL_GD_BLOCK)
+    if (rowset_size > 1 && !SQL_SUCCEEDED(SQLSetPos(hstmt, static_cast<SQLSETPOSIROW>(row + 1), SQL_POSITION,
+                                                    SQL_LOCK_NO_CHANGE))) {
+        OdbcUtils::ThrowException("position block cursor", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+    }
+    
+    if (column.variable_width) {
+        ReadLongColumn(hstmt, column_number, column, out, out_offset);
+        return;
+    }
+    
+    // Fixed-width values go through the row 0 slot of the column buffer
+    SQLRETURN rc = SQLGetData(hstmt, column_number, column.c_type, column.data.get(), 
+                              static_cast<SQLLEN>(column.value_width), column.indicators.get());
+    if (!SQL_SUCCEEDED(rc)) {
+        OdbcUtils::ThrowException("get column data", nanodbc::database_error(hstmt, SQL_HANDLE_STMT));
+    }
+    column.convert(column, out, 0, 1, out_offset);
+}
+
+void OdbcRowset::RefetchTruncated(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset) {
+    auto &column = columns[col_idx];
+    
+    // Bound columns can only be read again if the driver allows SQLGetData on them
+    if (!getdata_bound || (rowset_size > 1 && !getdata_block)) {
+        KeepTruncated(col_idx, row, out, out_offset);
+        return;
+    }
+    
+    // Position the block cursor on the row so SQLGetData can read the full value
+    if (rowset_size > 1 && !SQL_SUCCEEDED(SQLSetPos(hstmt, static_cast<SQLSETPOSIROW>(row + 1), 
+                                                    SQL_POSITION, SQL_LOCK_NO_CHANGE))) {
+        throw InvalidInputException("Value in result column %d exceeds the size described by the ODBC driver "
+                                    "and the driver does not support re-reading it; try a smaller batch_size", 
+                                    (int)(col_idx + 1));
+    }
+    
+    ReadLongColumn(hstmt, static_cast<SQLUSMALLINT>(col_idx + 1), column, out, out_offset);
+}
+
+void OdbcRowset::KeepTruncated(idx_t col_idx, idx_t row, Vector &out, idx_t out_offset) {
+    auto &column = columns[col_idx];
+    if (column.lob_overflow_null) {
+        FlatVector::Validity(out).SetInvalid(out_offset);
+        return;
+    }
+    auto data = const_char_ptr_cast(column.data.get() + row * column.value_width);
+    auto &target = FlatVector::GetData<string_t>(out)[out_offset];
+    if (column.wide) {
+        // Whole characters only: a trailing high surrogate is dropped
+        auto value = reinterpret_cast<const odbc_wide_unit_t *>(data);
+        auto count = (column.value_width - sizeof(SQLWCHAR)) / sizeof(SQLWCHAR);
+        if (sizeof(SQLWCHAR) == 2 && count > 0 && (value[count - 1] & 0xFC00) == 0xD800) {
+            count--;
+        }
+        bool over_limit;
+        target = OdbcEncoding::WideToVector(out, value, count, column.max_lob_size, over_limit);
+        return;
+    }
+    auto length = column.value_width - (column.c_type == SQL_C_CHAR ? 1 : 0);
+    length = CutLength(column, data, length);
+    if (column.encoding) {
+        target = column.encoding->ConvertToVector(out, data, length);
+        return;
+    }
+    if (column.c_type == SQL_C_CHAR) {
+        OdbcEncoding::VerifyUtf8(data, length);
+    }
+    target = StringVector::AddStringOrBlob(out, data, length);
+}
+
+void OdbcRowset::ReadLongColumn(SQLHSTMT hstmt, SQLUSMALLINT column_number, OdbcColumnBuffer &column, Vector &out,
+                                idx_t out_offset) {
+    string_t value;
+    if (ReadLongValue(hstmt, column_number, column, out, value)) {
+        FlatVector::GetData<string_t>(out)[out_offset] = ConvertLongValue(column, out, value);
+    } else {
+        FlatVector::Validity(out).SetInvalid(out_offset);
+    }
+}
+
+bool OdbcRowset::LimitLongValue(const OdbcColumnBuffer &column, const char *data, idx_t &length) {
+    if (!column.max_lob_size || length <= column.max_lob_size) {
+        return true;
+    }
+    if (column.lob_overflow_null) {
+        return false;
+    }
+    length = CutLength(column, data, column.max_lob_size);
+    return true;
+}
+
+void OdbcRowset::Scan(DataChunk &output, idx_t offset, idx_t count, idx_t out_offset, OdbcScanMetrics *metrics) {
+    D_ASSERT(output.ColumnCount() == columns.size());
+    for (idx_t col_idx = 0; col_idx < columns.size(); col_idx++) {
+        auto &column = columns[col_idx];
+        auto &out = output.data[col_idx];
+        // Unbound columns include their SQLGetData calls
+        OdbcScanTimer timer;
+        
+        if (!column.bound) {
+            for (idx_t i = 0; i < count; i++) {
+                ReadUnbound(col_idx, offset + i, out, out_offset + i);
+            }
+        } else {
+            column.convert(column, out, offset, count, out_offset);
+            if (column.variable_width) {
+                for (idx_t i = 0; i < count; i++) {
+                    if (IsStringTruncated(column, offset + i)) {
+                        RefetchTruncated(col_idx, offset + i, out, out_offset + i);
+                    }
+                }
+            }
+        }
+        
+        if (metrics) {
+            auto type_class = OdbcScanMetrics::GetTypeClass(out.GetType());
+            metrics->convert_ns[static_cast<idx_t>(type_class)] += timer.ElapsedNanos();
+        }
+    }
+}
+
+} // namespace duckdb
@@ -0,0 +1,179 @@
+#include "odbc_scan_stats.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// OdbcScanMetrics
+//------------------------------------------------------------------------------
+
+OdbcTypeClass OdbcScanMetrics::GetTypeClass(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::BOOLEAN:
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::UBIGINT:
+        case LogicalTypeId::HUGEINT:
+        case LogicalTypeId::FLOAT:
+        case LogicalTypeId::DOUBLE:
+        case LogicalTypeId::DECIMAL:
+            return OdbcTypeClass::NUMERIC;
+        case LogicalTypeId::VARCHAR:
+        case LogicalTypeId::BLOB:
+            return OdbcTypeClass::STRING;
+        case LogicalTypeId::DATE:
+        case LogicalTypeId::TIME:
+        case LogicalTypeId::TIMESTAMP:
+        case LogicalTypeId::TIMESTAMP_TZ:
+        case LogicalTypeId::INTERVAL:
+            return OdbcTypeClass::TEMPORAL;
+        default:
+            return OdbcTypeClass::OTHER;
+    }
+}
+
+void OdbcScanMetrics::AddBytes(DataChunk &chunk) {
+    auto count = chunk.size();
+    for (auto &vector : chunk.data) {
+        if (vector.GetType().InternalType() != PhysicalType::VARCHAR) {
+            bytes += count * GetTypeIdSize(vector.GetType().InternalType());
+            continue;
+        }
+        UnifiedVectorFormat format;
+        vector.ToUnifiedFormat(count, format);
+        auto strings = UnifiedVectorFormat::GetData<string_t>(format);
+        for (idx_t i = 0; i < count; i++) {
+            auto idx = format.sel->get_index(i);
+            if (format.validity.RowIsValid(idx)) {
+                bytes += strings[idx].GetSize();
+            }
+        }
+    }
+}
+
+void OdbcScanMetrics::Merge(const OdbcScanMetrics &other) {
+    connect_ns += other.connect_ns;
+    execute_ns += other.execute_ns;
+    fetch_ns += other.fetch_ns;
+    for (idx_t i = 0; i < ODBC_TYPE_CLASS_COUNT; i++) {
+        convert_ns[i] += other.convert_ns[i];
+    }
+    // The scan's first row is the first row of any of its threads
+    if (other.first_row_ns != 0 && (first_row_ns == 0 || other.first_row_ns < first_row_ns)) {
+        first_row_ns = other.first_row_ns;
+    }
+    rows += other.rows;
+    bytes += other.bytes;
+    rowsets += other.rowsets;
+}
+
+//------------------------------------------------------------------------------
+// OdbcScanStatsRegistry
+//------------------------------------------------------------------------------
+
+std::shared_ptr<OdbcScanStatsRegistry> OdbcScanStatsRegistry::Get(ClientContext &context) {
+    return ObjectCache::GetObjectCache(context).GetOrCreate<OdbcScanStatsRegistry>(ObjectType());
+}
+
+idx_t OdbcScanStatsRegistry::Register(std::string function, std::string target) {
+    lock_guard<mutex> guard(lock);
+    OdbcScanRecord record;
+    record.scan_id = next_scan_id++;
+    record.function = std::move(function);
+    record.target = std::move(target);
+    records.push_back(std::move(record));
+    while (records.size() > MAX_RECORDS) {
+        records.pop_front();
+    }
+    return records.back().scan_id;
+}
+
+void OdbcScanStatsRegistry::Merge(idx_t scan_id, const OdbcScanMetrics &metrics) {
+    lock_guard<mutex> guard(lock);
+    // Ids are handed out in order, so the record sits at a fixed offset from the front
+    if (records.empty() || scan_id < records.front().scan_id) {
+        return;
+    }
+    auto index = scan_id - records.front().scan_id;
+    if (index >= records.size()) {
+        return;
+    }
+    auto &record = records[index];
+    record.threads++;
+    record.metrics.Merge(metrics);
+}
+
+std::vector<OdbcScanRecord> OdbcScanStatsRegistry::GetRecords() {
+    lock_guard<mutex> guard(lock);
+    return std::vector<OdbcScanRecord>(records.begin(), records.end());
+}
+
+//------------------------------------------------------------------------------
+// odbc_scan_stats
+//------------------------------------------------------------------------------
+
+struct OdbcScanStatsState : public GlobalTableFunctionState {
+    std::vector<OdbcScanRecord> records;
+    idx_t position = 0;
+};
+
+static unique_ptr<FunctionData> BindScanStats(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+    names = {"scan_id", "function", "target", "threads", "rows", "bytes", "rowsets",
+             "connect_ms", "execute_ms", "first_row_ms", "fetch_ms",
+             "convert_numeric_ms", "convert_string_ms", "convert_temporal_ms", "convert_other_ms"};
+    // Counters first, all times in milliseconds
+    return_types = {LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT,
+                    LogicalType::BIGINT, LogicalType::BIGINT,  LogicalType::BIGINT};
+    while (return_types.size() < names.size()) {
+        return_types.push_back(LogicalType::DOUBLE);
+    }
+    return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> InitScanStats(ClientContext &context, TableFunctionInitInput &input) {
+    auto result = make_uniq<OdbcScanStatsState>();
+    result->records = OdbcScanStatsRegistry::Get(context)->GetRecords();
+    return std::move(result);
+}
+
+static Value Milliseconds(uint64_t nanos) {
+    return Value::DOUBLE(static_cast<double>(nanos) / 1e6);
+}
+
+static void ScanStats(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &state = data.global_state->Cast<OdbcScanStatsState>();
+    idx_t count = 0;
+    while (state.position < state.records.size() && count < STANDARD_VECTOR_SIZE) {
+        auto &record = state.records[state.position++];
+        auto &metrics = record.metrics;
+        idx_t col = 0;
+        output.SetValue(col++, count, Value::BIGINT(static_cast<int64_t>(record.scan_id)));
+        output.SetValue(col++, count, Value(record.function));
+        output.SetValue(col++, count, Value(record.target));
+        output.SetValue(col++, count, Value::BIGINT(static_cast<int64_t>(record.threads)));
+        output.SetValue(col++, count, Value::BIGINT(static_cast<int64_t>(metrics.rows)));
+        output.SetValue(col++, count, Value::BIGINT(static_cast<int64_t>(metrics.bytes)));
+        output.SetValue(col++, count, Value::BIGINT(static_cast<int64_t>(metrics.rowsets)));
+        output.SetValue(col++, count, Milliseconds(metrics.connect_ns));
+        output.SetValue(col++, count, Milliseconds(metrics.execute_ns));
+        output.SetValue(col++, count, Milliseconds(metrics.first_row_ns));
+        output.SetValue(col++, count, Milliseconds(metrics.fetch_ns));
+        for (idx_t i = 0; i < ODBC_TYPE_CLASS_COUNT; i++) {
+            output.SetValue(col++, count, Milliseconds(metrics.convert_ns[i]));
+        }
+        count++;
+    }
+    output.SetCardinality(count);
+}
+
+TableFunction OdbcScanStatsFunction() {
+    return TableFunction("odbc_scan_stats", {}, ScanStats, BindScanStats, InitScanStats);
+}
+
+} // namespace duckdb
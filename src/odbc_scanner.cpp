@@ -1,6 +1,13 @@
 #include "odbc_scanner.hpp"
+#include "odbc_driver_info.hpp"
 #include "odbc_utils.hpp"
 #include "odbc_encoding.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_filter_pushdown.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_schema_cache.hpp"
+#include "odbc_statistics.hpp"
+#include "odbc_cancel.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/timestamp.hpp"
@@ -10,6 +17,7 @@
 #include "duckdb/main/database_manager.hpp"
 #include "duckdb/main/attached_database.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
@@ -30,6 +38,11 @@ TableFunction OdbcTableFunction::CreateScanFunction() {
     result.init_global = InitOdbcGlobalState;
     result.init_local = InitOdbcLocalState;
     result.projection_pushdown = true;
+    result.filter_pushdown = true;
+    
+    // Remote row count and column ranges for the optimizer
+    result.cardinality = OdbcScanCardinality;
+    result.statistics = OdbcScanStatistics;
     
     // Add named parameters
     result.named_parameters["connection"] = LogicalType(LogicalTypeId::VARCHAR);
@@ -39,7 +52,19 @@ TableFunction OdbcTableFunction::CreateScanFunction() {
     result.named_parameters["all_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
     result.named_parameters["encoding"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["isolation"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["query_timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["fetch_timeout"] = LogicalType(LogicalTypeId::INTEGER);
     result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["batch_size"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["partition_column"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["partitions"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["snapshot"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["filter_pushdown"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["max_lob_size"] = LogicalType(LogicalTypeId::BIGINT);
+    result.named_parameters["lob_overflow"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["cache"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["cache_watermark"] = LogicalType(LogicalTypeId::VARCHAR);
     
     return result;
 }
@@ -62,6 +87,8 @@ TableFunction OdbcTableFunction::CreateAttachFunction() {
     result.named_parameters["encoding"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
     result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["filter_pushdown"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["cache"] = LogicalType(LogicalTypeId::BOOLEAN);
     
     return result;
 }
@@ -88,7 +115,15 @@ TableFunction OdbcTableFunction::CreateQueryFunction() {
     result.named_parameters["all_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
     result.named_parameters["encoding"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["isolation"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["query_timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["fetch_timeout"] = LogicalType(LogicalTypeId::INTEGER);
     result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+    result.named_parameters["batch_size"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["max_lob_size"] = LogicalType(LogicalTypeId::BIGINT);
+    result.named_parameters["lob_overflow"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["params"] = LogicalType::ANY;
+    result.named_parameters["cache"] = LogicalType(LogicalTypeId::BOOLEAN);
     
     return result;
 }
@@ -101,23 +136,317 @@ TableFunction OdbcTableFunction::CreateExecFunction() {
                      vector<LogicalType> &return_types, vector<string> &names) -> unique_ptr<FunctionData> {
         return BindOdbcFunction(context, input, return_types, names, OdbcOperation::EXEC);
     };
+    result.init_global = InitOdbcExecState;
     
     // Add named parameters
     result.named_parameters["connection"] = LogicalType(LogicalTypeId::VARCHAR);
-    result.named_parameters["sql"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["sql"] = LogicalType::ANY;
+    result.named_parameters["transaction"] = LogicalType(LogicalTypeId::BOOLEAN);
     result.named_parameters["username"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["password"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["encoding"] = LogicalType(LogicalTypeId::VARCHAR);
     result.named_parameters["timeout"] = LogicalType(LogicalTypeId::INTEGER);
+    result.named_parameters["isolation"] = LogicalType(LogicalTypeId::VARCHAR);
+    result.named_parameters["query_timeout"] = LogicalType(LogicalTypeId::INTEGER);
     result.named_parameters["read_only"] = LogicalType(LogicalTypeId::BOOLEAN);
     
     return result;
 }
 
+//------------------------------------------------------------------------------
+// Query Parameters
+//------------------------------------------------------------------------------
+
+// Bind the params of odbc_query to the parameter markers of a prepared statement
+static void BindQueryParameters(OdbcStatement &statement, const std::vector<Value> &parameters) {
+    // Drivers that cannot count the markers before executing report the mismatch themselves
+    SQLSMALLINT marker_count = 0;
+    if (SQL_SUCCEEDED(SQLNumParams(statement.GetNativeHandle(), &marker_count)) &&
+        static_cast<idx_t>(marker_count) != parameters.size()) {
+        throw BinderException("Query has %d parameter markers but %d params were given", (int)marker_count,
+                              (int)parameters.size());
+    }
+    for (idx_t i = 0; i < parameters.size(); i++) {
+        statement.BindParameter(i, parameters[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Partitioning
+//------------------------------------------------------------------------------
+
+// Quoted, optionally schema-qualified name of the scanned table
+std::string QuoteTableName(const OdbcScannerState &bind_data) {
+    auto table = "\"" + OdbcUtils::SanitizeString(bind_data.table_name) + "\"";
+    if (bind_data.schema_name.empty()) {
+        return table;
+    }
+    return "\"" + OdbcUtils::SanitizeString(bind_data.schema_name) + "\"." + table;
+}
+
+static bool IsIntegerKeyType(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+            return true;
+        case LogicalTypeId::DECIMAL:
+            // e.g. Oracle NUMBER(10)
+            return DecimalType::GetScale(type) == 0 && DecimalType::GetWidth(type) <= 18;
+        default:
+            return false;
+    }
+}
+
+static std::vector<std::string> CreatePartitionPredicates(ClientContext &context, OdbcConnection &db,
+                                                          const OdbcScannerState &bind_data,
+                                                          const OdbcScanParameters &params,
+                                                          std::vector<std::vector<Value>> &bounds) {
+    std::vector<std::string> predicates;
+    
+    // Use the requested column or fall back to a single-column primary key
+    std::string column = params.partition_column;
+    if (column.empty()) {
+        column = db.GetPrimaryKeyColumn(bind_data.table_name);
+        if (column.empty()) {
+            throw BinderException("Cannot partition table '%s': no partition_column given and the table "
+                                  "has no single-column primary key", bind_data.table_name);
+        }
+    }
+    
+    bool found = false;
+    for (auto &name : bind_data.column_names) {
+        if (StringUtil::CIEquals(name, column)) {
+            column = name;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        throw BinderException("Partition column '%s' not found in table '%s'", column, bind_data.table_name);
+    }
+    
+    // The bounds are read as 64-bit integers, so only exact integer keys can be split.
+    // With all_varchar the bound types say nothing, so the remote types are looked up.
+    LogicalType key_type;
+    if (bind_data.options.all_varchar) {
+        ColumnList columns;
+        std::vector<std::unique_ptr<Constraint>> constraints;
+        db.GetTableInfo(bind_data.table_name, columns, constraints, false);
+        for (auto &entry : columns.Logical()) {
+            if (entry.GetName() == column) {
+                key_type = entry.GetType();
+            }
+        }
+    } else {
+        for (idx_t i = 0; i < bind_data.column_names.size(); i++) {
+            if (bind_data.column_names[i] == column) {
+                key_type = bind_data.column_types[i];
+            }
+        }
+    }
+    if (!IsIntegerKeyType(key_type)) {
+        throw BinderException("Partition column '%s' of table '%s' must have an exact integer type, not %s",
+                              column, bind_data.table_name, key_type.ToString());
+    }
+    
+    idx_t partition_count = params.partitions;
+    if (partition_count == 0) {
+        partition_count = TaskScheduler::GetScheduler(context).NumberOfThreads();
+    }
+    if (partition_count <= 1) {
+        return predicates;
+    }
+    
+    // Find the key range on the remote side
+    auto quoted_column = "\"" + OdbcUtils::SanitizeString(column) + "\"";
+    auto range_sql = StringUtil::Format("SELECT MIN(%s), MAX(%s) FROM %s", quoted_column, quoted_column,
+                                        QuoteTableName(bind_data));
+    auto stmt = db.Prepare(range_sql);
+    if (!stmt->Step() || stmt->IsNull(0) || stmt->IsNull(1)) {
+        // Empty table - nothing to split
+        return predicates;
+    }
+    int64_t min_value = stmt->GetInt64(0);
+    int64_t max_value = stmt->GetInt64(1);
+    stmt->Close();
+    
+    // Compute the range boundaries with unsigned arithmetic so that the full
+    // int64 domain cannot overflow
+    uint64_t range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+    uint64_t stride = range / partition_count + 1;
+    std::vector<int64_t> boundaries;
+    for (uint64_t offset = stride; boundaries.size() + 1 < partition_count && offset <= range; offset += stride) {
+        boundaries.push_back(static_cast<int64_t>(static_cast<uint64_t>(min_value) + offset));
+        if (offset > range - stride) {
+            break;
+        }
+    }
+    if (boundaries.empty()) {
+        return predicates;
+    }
+    
+    // The first range also picks up NULL keys and the last one is open-ended,
+    // so rows that do not fall into [min, max] at bind time are never lost. The bounds
+    // are sent as parameters: the inner ranges share one query text and thereby one
+    // prepared statement per connection.
+    predicates.push_back(StringUtil::Format("%s < ? OR %s IS NULL", quoted_column, quoted_column));
+    bounds.push_back({Value::BIGINT(boundaries.front())});
+    for (idx_t i = 1; i < boundaries.size(); i++) {
+        predicates.push_back(StringUtil::Format("%s >= ? AND %s < ?", quoted_column, quoted_column));
+        bounds.push_back({Value::BIGINT(boundaries[i - 1]), Value::BIGINT(boundaries[i])});
+    }
+    predicates.push_back(StringUtil::Format("%s >= ?", quoted_column));
+    bounds.push_back({Value::BIGINT(boundaries.back())});
+    
+    return predicates;
+}
+
+//------------------------------------------------------------------------------
+// Result Cache
+//------------------------------------------------------------------------------
+
+// Watermarks are compared on the remote side, so they need a portable literal
+static bool IsWatermarkType(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::UBIGINT:
+        case LogicalTypeId::DECIMAL:
+        case LogicalTypeId::DATE:
+        case LogicalTypeId::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Index of the cache_watermark column of odbc_scan
+static idx_t FindWatermarkColumn(const OdbcScannerState &bind_data, const std::string &name) {
+    for (idx_t i = 0; i < bind_data.column_names.size(); i++) {
+        if (StringUtil::CIEquals(bind_data.column_names[i], name)) {
+            if (!IsWatermarkType(bind_data.column_types[i])) {
+                throw BinderException("Watermark column '%s' must be an integer, DECIMAL, DATE or TIMESTAMP "
+                                      "column, got %s", name, bind_data.column_types[i].ToString());
+            }
+            return i;
+        }
+    }
+    throw BinderException("Watermark column '%s' not found in table '%s'", name, bind_data.table_name);
+}
+
+// Results are keyed by data source, generated SQL, parameters and everything that changes the values
+static std::string ResultCacheKey(const OdbcScannerState &bind_data, const std::string &sql,
+                                  const vector<LogicalType> &types) {
+    auto key = bind_data.connection_params.GetKey() + '\x1e' + sql + '\x1e' +
+               OdbcEncoding::NormalizeEncodingName(bind_data.options.encoding) + '\x1e' +
+               std::to_string(bind_data.options.max_lob_size) + (bind_data.options.lob_overflow_null ? "null" : "");
+    for (auto &type : types) {
+        key += '\x1e' + type.ToString();
+    }
+    for (auto &parameter : bind_data.parameters) {
+        key += '\x1e' + parameter.type().ToString() + ':' + parameter.ToString();
+    }
+    // Results kept current by a watermark are separate from plain snapshots
+    return key + '\x1e' + bind_data.cache_watermark;
+}
+
+static std::string WatermarkLiteral(const Value &value) {
+    std::string literal;
+    if (!OdbcFilterPushdown::TryGetLiteral(value, literal)) {
+        throw InvalidInputException("Watermark value %s cannot be sent to the data source", value.ToString());
+    }
+    return literal;
+}
+
+// Current maximum of the watermark column among the rows the scan selects (NULL if none has a value).
+// With a cached result, also counts the selected rows the cached result covers, i.e. rows without
+// a value or up to its watermark, in covered_rows.
+static Value ReadWatermark(OdbcConnection &db, const OdbcScannerState &bind_data, const std::string &filter_sql,
+                           const OdbcCachedResult *cached, idx_t &covered_rows) {
+    auto &type = bind_data.column_types[FindWatermarkColumn(bind_data, bind_data.cache_watermark)];
+    auto column = "\"" + OdbcUtils::SanitizeString(bind_data.cache_watermark) + "\"";
+    auto sql = "SELECT MAX(" + column + ")";
+    if (cached) {
+        auto covered = column + " IS NULL";
+        if (!cached->watermark.IsNull()) {
+            covered += " OR " + column + " <= " + WatermarkLiteral(cached->watermark);
+        }
+        sql += ", COUNT(CASE WHEN " + covered + " THEN 1 END)";
+    }
+    sql += " FROM " + QuoteTableName(bind_data);
+    if (!filter_sql.empty()) {
+        sql += " WHERE " + filter_sql;
+    }
+    
+    Value result(type);
+    covered_rows = 0;
+    try {
+        auto stmt = db.Prepare(sql);
+        if (stmt->Step()) {
+            if (!stmt->IsNull(0)) {
+                auto text = stmt->GetString(0);
+                if (!Value(text).DefaultTryCastAs(type, result)) {
+                    throw InvalidInputException("Could not convert watermark \"%s\" to %s", text, type.ToString());
+                }
+            }
+            if (cached) {
+                covered_rows = static_cast<idx_t>(stmt->GetInt64(1));
+            }
+        }
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("read cache watermark", e);
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // Binding Functions
 //------------------------------------------------------------------------------
 
+unique_ptr<NodeStatistics> OdbcScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+    auto &bind_data = bind_data_p->CastNoConst<OdbcScannerState>();
+    if (bind_data.cardinality_pending) {
+        // Estimated once per table and remembered with its schema
+        bind_data.cardinality_pending = false;
+        try {
+            auto db = bind_data.global_connection ? bind_data.global_connection
+                                                  : OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+            bind_data.estimated_cardinality = OdbcStatistics::EstimateRowCount(context, *db, bind_data.dbms_name,
+                                                                               std::string(), bind_data.table_name);
+        } catch (const std::exception &) {
+            // Connection failures surface when the scan starts
+        }
+        auto schema_cache = OdbcSchemaCache::Get(context);
+        auto cache_key = OdbcSchemaCache::TableKey(bind_data.connection_params, bind_data.table_name,
+                                                   bind_data.options.all_varchar);
+        OdbcSchema schema;
+        if (schema_cache->Lookup(cache_key, schema)) {
+            schema.cardinality = bind_data.estimated_cardinality;
+            schema.cardinality_estimated = true;
+            schema_cache->Store(cache_key, std::move(schema));
+        }
+    }
+    if (!bind_data.estimated_cardinality.IsValid()) {
+        return make_uniq<NodeStatistics>();
+    }
+    return make_uniq<NodeStatistics>(bind_data.estimated_cardinality.GetIndex());
+}
+
+unique_ptr<BaseStatistics> OdbcScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                              column_t column_id) {
+    return OdbcStatistics::GetColumnStatistics(context, bind_data_p->Cast<OdbcScannerState>(), column_id);
+}
+
 unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context, TableFunctionBindInput &input,
                                         vector<LogicalType> &return_types, vector<string> &names,
                                         OdbcOperation operation) {
@@ -129,27 +458,74 @@ unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context, TableFunctionB
             result->table_name = params.table_name;
             result->options = params.options;
             
-            // Connect to data source and get schema
+            // Connect to data source and get schema, unless it was read recently
             try {
-                auto db = OdbcConnection::Connect(result->connection_params);
-                
-                // Get table information
-                ColumnList columns;
-                std::vector<std::unique_ptr<Constraint>> constraints;
-                db->GetTableInfo(result->table_name, columns, constraints, result->options.all_varchar);
+                auto schema_cache = OdbcSchemaCache::Get(context);
+                auto cache_key = OdbcSchemaCache::TableKey(result->connection_params, result->table_name,
+                                                           result->options.all_varchar);
+                bool partitioned = params.partitions > 1 || !params.partition_column.empty();
                 
-                // Map column types and names
-                for (auto &column : columns.Logical()) {
-                    names.push_back(column.GetName());
-                    return_types.push_back(column.GetType());
+                OdbcSchema schema;
+                bool cached = schema_cache->Lookup(cache_key, schema);
+                std::shared_ptr<OdbcConnection> db;
+                if (!cached || partitioned) {
+                    db = OdbcConnectionPool::Acquire(context, result->connection_params);
                 }
                 
-                if (names.empty()) {
-                    throw BinderException("No columns found for table " + result->table_name);
+                if (!cached) {
+                    // Get table information
+                    ColumnList columns;
+                    std::vector<std::unique_ptr<Constraint>> constraints;
+                    db->GetTableInfo(result->table_name, columns, constraints, result->options.all_varchar);
+                    
+                    // Map column types and names
+                    for (auto &column : columns.Logical()) {
+                        schema.names.push_back(column.GetName());
+                        schema.types.push_back(column.GetType());
+                    }
+                    
+                    if (schema.names.empty()) {
+                        throw BinderException("No columns found for table " + result->table_name);
+                    }
+                    
+                    try {
+                        schema.dbms_name = db->GetNativeConnection().dbms_name();
+                    } catch (const nanodbc::database_error&) {
+                        // Unknown DBMS - dialect specific pushdown stays off
+                    }
+                    schema.cardinality = OdbcStatistics::EstimateRowCount(context, *db, schema.dbms_name,
+                                                                          std::string(), result->table_name);
+                    schema_cache->Store(cache_key, schema);
                 }
                 
+                names = schema.names;
+                return_types = schema.types;
                 result->column_names = names;
                 result->column_types = return_types;
+                result->dbms_name = schema.dbms_name;
+                result->estimated_cardinality = schema.cardinality;
+                result->cardinality_pending = !schema.cardinality_estimated;
+                
+                if (!params.cache_watermark.empty()) {
+                    auto index = FindWatermarkColumn(*result, params.cache_watermark);
+                    result->cache_watermark = result->column_names[index];
+                }
+                
+                // Split the scan into key ranges so that it can run on several threads. Without a
+                // snapshot that can be shared between sessions each range would see its own point
+                // in time, so a consistent read falls back to a single cursor.
+                result->snapshot = params.snapshot;
+                if (partitioned && params.snapshot && OdbcDialect::ExportSnapshotQuery(result->dbms_name).empty()) {
+                    partitioned = false;
+                }
+                if (partitioned) {
+                    result->partition_predicates = CreatePartitionPredicates(context, *db, *result, params,
+                                                                                  result->partition_bounds);
+                    result->partition_column = params.partition_column;
+                }
+                
+                // Null on a cache hit - the scan then takes a connection from the pool
+                result->global_connection = std::move(db);
                 
             } catch (const nanodbc::database_error& e) {
                 OdbcUtils::ThrowException("bind scan function", e);
@@ -163,39 +539,62 @@ unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context, TableFunctionB
             auto result = make_uniq<OdbcScannerState>();
             result->connection_params = params.connection;
             result->sql = params.query;
+            result->parameters = std::move(params.params);
             result->options = params.options;
             
-            // Connect to data source and get schema
+            // Describe the prepared query, unless it was described recently. Binding never runs
+            // the query: statements without a result are executed by the scan.
             try {
-                auto db = OdbcConnection::Connect(result->connection_params);
-                auto stmt = db->Prepare(result->sql);
+                auto schema_cache = OdbcSchemaCache::Get(context);
+                auto cache_key = OdbcSchemaCache::QueryKey(result->connection_params, result->sql,
+                                                           result->options.all_varchar);
+                // The prepared statement is kept by the connection, which the scan reuses
+                auto db = OdbcConnectionPool::Acquire(context, result->connection_params);
                 
-                // Get column information
-                auto columnCount = stmt->GetColumnCount();
-                
-                if (columnCount == 0) {
-                    // DDL statement - add success column
-                    names.push_back("Success");
-                    return_types.push_back(LogicalType(LogicalTypeId::BOOLEAN));
-                } else {
-                    // Regular query with results
-                    for (idx_t i = 0; i < columnCount; i++) {
-                        auto colName = stmt->GetName(i);
-                        SQLULEN size = 0;
-                        SQLSMALLINT digits = 0;
-                        SQLSMALLINT odbcType = stmt->GetOdbcType(i, &size, &digits);
-
-                        auto duckType = result->options.all_varchar ? 
-                                      LogicalType::VARCHAR : 
-                                      OdbcUtils::OdbcTypeToLogicalType(odbcType, size, digits);
-                        
-                        names.push_back(colName);
-                        return_types.push_back(duckType);
+                OdbcSchema schema;
+                if (!schema_cache->Lookup(cache_key, schema)) {
+                    auto stmt = db->PrepareCached(result->sql);
+                    BindQueryParameters(*stmt, result->parameters);
+                    
+                    // Get column information (SQLNumResultCols / SQLDescribeCol on the prepared statement)
+                    auto columnCount = stmt->GetColumnCount();
+                    
+                    if (columnCount == 0) {
+                        // DDL statement - add success column
+                        schema.names.push_back("Success");
+                        schema.types.push_back(LogicalType(LogicalTypeId::BOOLEAN));
+                    } else {
+                        // Regular query with results
+                        for (idx_t i = 0; i < columnCount; i++) {
+                            auto colName = stmt->GetName(i);
+                            SQLULEN size = 0;
+                            SQLSMALLINT digits = 0;
+                            SQLSMALLINT odbcType = stmt->GetOdbcType(i, &size, &digits);
+
+                            auto duckType = result->options.all_varchar ? 
+                                          LogicalType::VARCHAR : 
+                                          OdbcUtils::OdbcTypeToLogicalType(odbcType, size, digits);
+                            
+                            schema.names.push_back(colName);
+                            schema.types.push_back(duckType);
+                        }
                     }
+                    db->ReleaseStatement(std::move(stmt));
+                    
+                    try {
+                        schema.dbms_name = db->GetNativeConnection().dbms_name();
+                    } catch (const nanodbc::database_error&) {
+                        // Unknown DBMS - dialect specific pushdown stays off
+                    }
+                    schema_cache->Store(cache_key, schema);
                 }
                 
+                names = schema.names;
+                return_types = schema.types;
                 result->column_names = names;
                 result->column_types = return_types;
+                result->dbms_name = schema.dbms_name;
+                result->global_connection = std::move(db);
                 
             } catch (const nanodbc::database_error& e) {
                 OdbcUtils::ThrowException("bind query function", e);
@@ -208,12 +607,17 @@ unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context, TableFunctionB
             auto params = OdbcParameterParser::ParseExecParameters(input);
             auto result = make_uniq<OdbcExecFunctionData>();
             result->connection_params = params.connection;
-            result->sql = params.sql;
+            result->statements = std::move(params.statements);
             result->options = params.options;
+            result->transaction = params.transaction;
             
-            // Set up return types (single boolean column)
+            // One row per statement, with its position and SQLRowCount (NULL if unknown)
             return_types.emplace_back(LogicalTypeId::BOOLEAN);
             names.emplace_back("Success");
+            return_types.emplace_back(LogicalTypeId::INTEGER);
+            names.emplace_back("statement_index");
+            return_types.emplace_back(LogicalTypeId::BIGINT);
+            names.emplace_back("rows_affected");
             
             return std::move(result);
         }
@@ -240,54 +644,364 @@ unique_ptr<FunctionData> BindOdbcFunction(ClientContext &context, TableFunctionB
 // State Initialization
 //------------------------------------------------------------------------------
 
+static std::string BuildScanQuery(const OdbcScannerState &bind_data, const std::vector<column_t> &column_ids,
+                                  const std::string &predicate) {
+    if (!bind_data.sql.empty()) {
+        return bind_data.sql;
+    }
+    
+    // Build query based on column IDs
+    auto colNames = StringUtil::Join(
+        column_ids.data(), column_ids.size(), ", ", [&](const idx_t columnId) {
+            return columnId == (column_t)-1 ? "NULL"
+                                          : '"' + OdbcUtils::SanitizeString(bind_data.column_names[columnId]) + '"';
+        });
+        
+    auto table_expression = "FROM " + QuoteTableName(bind_data);
+    if (!predicate.empty()) {
+        table_expression += " WHERE " + predicate;
+    }
+    
+    if (bind_data.row_limit.IsValid()) {
+        auto syntax = OdbcDialect::GetLimitSyntax(bind_data.dbms_name);
+        return OdbcDialect::LimitQuery(syntax, colNames, table_expression, bind_data.order_by, 
+                                       bind_data.row_limit.GetIndex());
+    }
+    return "SELECT " + colNames + " " + table_expression;
+}
+
+// Claim the next key range from the global state and prepare its query on the
+// thread's own connection. Returns false once every range has been handed out.
+static bool StartNextPartition(ClientContext &context, const OdbcScannerState &bind_data, 
+                               OdbcGlobalScanState &global_state, OdbcLocalScanState &state) {
+    std::string predicate;
+    idx_t partition;
+    {
+        lock_guard<mutex> guard(global_state.lock);
+        if (global_state.position >= global_state.partitions.size()) {
+            return false;
+        }
+        partition = global_state.position++;
+        predicate = global_state.partitions[partition];
+        if (!state.connection) {
+            state.connection = std::move(global_state.connection);
+        }
+    }
+    
+    try {
+        if (!state.connection) {
+            OdbcScopedTimer timer(state.metrics.connect_ns);
+            state.connection = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+        }
+        // Move the thread's connection onto the shared snapshot before its first range
+        if (!global_state.snapshot_id.empty() && !state.snapshot_transaction) {
+            state.snapshot_transaction = make_uniq<nanodbc::transaction>(state.connection->GetNativeConnection());
+            for (auto &statement : OdbcDialect::ImportSnapshotStatements(bind_data.dbms_name,
+                                                                         global_state.snapshot_id)) {
+                state.connection->Execute(statement);
+            }
+        }
+        
+        // The bound buffers are reused for the next statement
+        if (state.rowset) {
+            state.rowset->Unbind();
+        }
+        state.rowset_bound = false;
+        state.rowset_offset = 0;
+        state.rowset_count = 0;
+        state.statement_rows = 0;
+        if (state.statement) {
+            state.connection->ReleaseStatement(std::move(state.statement));
+        }
+        
+        // Prepare the statement and fetch in blocks of batch_size rows. Queries, repeated
+        // scans and ranges of the same shape have the same text, so their prepared
+        // statement is reused from the connection's statement cache.
+        OdbcScopedTimer timer(state.metrics.execute_ns);
+        if (bind_data.sql.empty()) {
+            state.statement = state.connection->PrepareCached(BuildScanQuery(bind_data, state.column_ids, predicate));
+            if (!bind_data.partition_bounds.empty()) {
+                BindQueryParameters(*state.statement, bind_data.partition_bounds[partition]);
+            }
+        } else {
+            state.statement = state.connection->PrepareCached(bind_data.sql);
+            BindQueryParameters(*state.statement, bind_data.parameters);
+        }
+        state.statement->SetRowsetSize(state.connection->GetDriverInfo().LimitRowsetSize(bind_data.options.batch_size));
+        state.statement->SetQueryTimeout(bind_data.options.query_timeout);
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("initialize scanner", e);
+    }
+    
+    return true;
+}
+
+// Output types of the scan in column order (projected columns for odbc_scan)
+static vector<LogicalType> GetScanTypes(const OdbcScannerState &bind_data, const std::vector<column_t> &column_ids) {
+    if (!bind_data.sql.empty()) {
+        return bind_data.column_types;
+    }
+    vector<LogicalType> types;
+    for (auto column_id : column_ids) {
+        types.push_back(column_id == (column_t)-1 ? LogicalType(LogicalType::ROW_TYPE)
+                                                      : bind_data.column_types[column_id]);
+    }
+    return types;
+}
+
+// odbc_query of a statement without a result (see BindOdbcFunction)
+static bool IsStatement(const OdbcScannerState &bind_data) {
+    return bind_data.column_names.size() == 1 && bind_data.column_names[0] == "Success";
+}
+
+// Restrict every range of the scan by an additional predicate
+static void AddPartitionPredicate(OdbcGlobalScanState &gstate, const std::string &predicate) {
+    if (predicate.empty()) {
+        return;
+    }
+    for (auto &partition : gstate.partitions) {
+        partition = partition.empty() ? predicate : "(" + partition + ") AND " + predicate;
+    }
+}
+
+// Do not read from the source at all, only return the cached result
+static void ServeFromCache(OdbcGlobalScanState &gstate) {
+    gstate.partitions.clear();
+    gstate.max_thread_count = 1;
+    gstate.cache_store = false;
+}
+
+// Look the scan up in the result cache. A hit is returned as is, or with a watermark
+// followed by the rows whose watermark is past the cached one. The rows read are
+// bounded by the maximum watermark at the start, so rows written meanwhile are left
+// to the next refresh and never read twice. Appending is only valid for append-only
+// tables: if the rows the cached result covers no longer add up to its row count
+// (rows were updated past the watermark, deleted or inserted below it), the cached
+// result is dropped and read again in full.
+static void InitResultCache(ClientContext &context, const OdbcScannerState &bind_data,
+                            const vector<column_t> &column_ids, const std::string &filter_sql,
+                            OdbcGlobalScanState &gstate) {
+    gstate.result_cache = OdbcResultCache::Get(context);
+    gstate.cache_key = ResultCacheKey(bind_data, BuildScanQuery(bind_data, column_ids, filter_sql),
+                                      GetScanTypes(bind_data, column_ids));
+    gstate.cached_result = gstate.result_cache->Lookup(gstate.cache_key);
+    gstate.cache_store = true;
+    
+    // A pushed LIMIT selects other rows once the table grows, so it is cached as is
+    bool refresh = !bind_data.cache_watermark.empty() && !bind_data.row_limit.IsValid();
+    if (!refresh) {
+        if (gstate.cached_result) {
+            ServeFromCache(gstate);
+        }
+        return;
+    }
+    
+    if (!gstate.connection) {
+        try {
+            gstate.connection = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+        } catch (const nanodbc::database_error &e) {
+            OdbcUtils::ThrowException("read cache watermark", e);
+        }
+    }
+    idx_t covered_rows;
+    gstate.cache_watermark =
+        ReadWatermark(*gstate.connection, bind_data, filter_sql, gstate.cached_result.get(), covered_rows);
+    if (gstate.cached_result && covered_rows != gstate.cached_result->Count()) {
+        gstate.cached_result.reset();
+    }
+    auto column = "\"" + OdbcUtils::SanitizeString(bind_data.cache_watermark) + "\"";
+    std::string upper_bound;
+    if (!gstate.cache_watermark.IsNull()) {
+        upper_bound = column + " <= " + WatermarkLiteral(gstate.cache_watermark);
+    }
+    
+    if (!gstate.cached_result) {
+        // First read: everything up to the watermark, including rows without a value
+        AddPartitionPredicate(gstate, upper_bound.empty() ? "" : "(" + column + " IS NULL OR " + upper_bound + ")");
+        return;
+    }
+    
+    auto &previous = gstate.cached_result->watermark;
+    if (gstate.cache_watermark.IsNull() || (!previous.IsNull() && gstate.cache_watermark <= previous)) {
+        // No new rows
+        ServeFromCache(gstate);
+        return;
+    }
+    auto lower_bound = previous.IsNull() ? column + " IS NOT NULL" : column + " > " + WatermarkLiteral(previous);
+    AddPartitionPredicate(gstate, lower_bound + " AND " + upper_bound);
+}
+
+// Export the snapshot of a transaction that the threads of a partitioned scan import before
+// reading their ranges, so that all ranges see the table at the same point in time
+static void InitSnapshot(ClientContext &context, const OdbcScannerState &bind_data, OdbcGlobalScanState &gstate) {
+    auto query = OdbcDialect::ExportSnapshotQuery(bind_data.dbms_name);
+    D_ASSERT(!query.empty());
+    try {
+        gstate.snapshot_connection = std::move(gstate.connection);
+        if (!gstate.snapshot_connection) {
+            gstate.snapshot_connection = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+        }
+        gstate.snapshot_transaction =
+            make_uniq<nanodbc::transaction>(gstate.snapshot_connection->GetNativeConnection());
+        auto statement = gstate.snapshot_connection->Prepare(query);
+        if (!statement->Step() || statement->IsNull(0)) {
+            throw InvalidInputException("The ODBC data source did not export a snapshot");
+        }
+        gstate.snapshot_id = statement->GetString(0);
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("export snapshot", e);
+    }
+}
+
 unique_ptr<GlobalTableFunctionState> InitOdbcGlobalState(ClientContext &context, TableFunctionInitInput &input) {
-    return make_uniq<OdbcGlobalScanState>(1); // Single-threaded scan for now
+    auto &bind_data = input.bind_data->CastNoConst<OdbcScannerState>();
+    
+    unique_ptr<OdbcGlobalScanState> result;
+    if (bind_data.partition_predicates.empty()) {
+        // Single serial scan without a range predicate
+        result = make_uniq<OdbcGlobalScanState>(1);
+        result->partitions.emplace_back();
+    } else {
+        // One thread per key range at most
+        result = make_uniq<OdbcGlobalScanState>(bind_data.partition_predicates.size());
+        result->partitions = bind_data.partition_predicates;
+    }
+    
+    // Send the pushed-down filters along with every range. With all_varchar the
+    // local types do not match the remote columns, so filters are applied locally.
+    std::string filter_sql;
+    if (bind_data.sql.empty()) {
+        bool push_filters = bind_data.options.filter_pushdown && !bind_data.options.all_varchar;
+        auto scan_types = GetScanTypes(bind_data, input.column_ids);
+        filter_sql = OdbcFilterPushdown::TransformFilters(input.column_ids, scan_types, bind_data.column_names,
+                                                          input.filters, push_filters, result->residual_filter);
+        AddPartitionPredicate(*result, filter_sql);
+    }
+    
+    // Reuse the bind-time connection; later executions of the same bind data
+    // get theirs from the pool
+    result->connection = std::move(bind_data.global_connection);
+    
+    if (bind_data.options.cache && !IsStatement(bind_data)) {
+        InitResultCache(context, bind_data, input.column_ids, filter_sql, *result);
+    }
+    if (bind_data.snapshot && result->partitions.size() > 1) {
+        InitSnapshot(context, bind_data, *result);
+    }
+    
+    result->stats_registry = OdbcScanStatsRegistry::Get(context);
+    if (bind_data.sql.empty()) {
+        result->scan_id = result->stats_registry->Register("odbc_scan", QuoteTableName(bind_data));
+    } else {
+        result->scan_id = result->stats_registry->Register("odbc_query", bind_data.sql);
+    }
+    return std::move(result);
 }
 
+static void ScanOdbcChunk(ClientContext &context, const OdbcScannerState &bind_data, OdbcGlobalScanState &gstate,
+                          OdbcLocalScanState &state, DataChunk &output);
+
 unique_ptr<LocalTableFunctionState> InitOdbcLocalState(ExecutionContext &context, TableFunctionInitInput &input, 
                                                      GlobalTableFunctionState *global_state) {
     auto &bind_data = input.bind_data->Cast<OdbcScannerState>();
+    auto &gstate = global_state->Cast<OdbcGlobalScanState>();
     auto result = make_uniq<OdbcLocalScanState>();
     
     // Store column IDs from input
     result->column_ids = input.column_ids;
+    result->stats_registry = gstate.stats_registry;
+    result->scan_id = gstate.scan_id;
     
-    try {
-        // Create connection
-        result->connection = OdbcConnection::Connect(bind_data.connection_params);
-        
-        // Special handling for DDL statements
-        if (bind_data.column_names.size() == 1 && bind_data.column_names[0] == "Success") {
-            try {
-                result->connection->Execute(bind_data.sql);
-                result->done = false;
-            } catch (const nanodbc::database_error& e) {
-                OdbcUtils::ThrowException("execute statement", e);
+    // Special handling for DDL statements
+    if (bind_data.column_names.size() == 1 && bind_data.column_names[0] == "Success") {
+        try {
+            {
+                lock_guard<mutex> guard(gstate.lock);
+                result->connection = std::move(gstate.connection);
             }
-            return std::move(result);
+            if (!result->connection) {
+                result->connection = OdbcConnectionPool::Acquire(context.client, bind_data.connection_params);
+            }
+            // Long DDL/DML can be interrupted like a scan
+            if (bind_data.parameters.empty()) {
+                result->connection->Execute(context.client, bind_data.sql, bind_data.options.query_timeout);
+            } else {
+                auto statement = result->connection->PrepareCached(bind_data.sql);
+                BindQueryParameters(*statement, bind_data.parameters);
+                statement->SetQueryTimeout(bind_data.options.query_timeout);
+                {
+                    OdbcCancelGuard cancel(context.client, statement->GetNativeHandle(),
+                                           bind_data.options.query_timeout, "query_timeout");
+                    try {
+                        statement->Execute();
+                    } catch (...) {
+                        cancel.ThrowIfCancelled();
+                        throw;
+                    }
+                }
+                result->connection->ReleaseStatement(std::move(statement));
+            }
+            // The statement may have changed remote tables
+            OdbcSchemaCache::Get(context.client)->Clear();
+            OdbcResultCache::Get(context.client)->Clear();
+            result->done = false;
+        } catch (const nanodbc::database_error& e) {
+            OdbcUtils::ThrowException("execute statement", e);
         }
-        
-        // Prepare the query
-        std::string sql;
-        if (bind_data.sql.empty()) {
-            // Build query based on column IDs
-            auto colNames = StringUtil::Join(
-                result->column_ids.data(), result->column_ids.size(), ", ", [&](const idx_t columnId) {
-                    return columnId == (column_t)-1 ? "NULL"
-                                                  : '"' + OdbcUtils::SanitizeString(bind_data.column_names[columnId]) + '"';
-                });
-                
-            sql = StringUtil::Format("SELECT %s FROM \"%s\"", colNames, 
-                                   OdbcUtils::SanitizeString(bind_data.table_name));
-        } else {
-            sql = bind_data.sql;
+        return std::move(result);
+    }
+    
+    // Resolve the per-column converters once; types without a bound-buffer
+    // converter keep using the row-by-row path
+    auto scan_types = GetScanTypes(bind_data, result->column_ids);
+    if (gstate.residual_filter) {
+        result->filter_executor = make_uniq<ExpressionExecutor>(context.client, *gstate.residual_filter);
+    }
+    if (OdbcRowset::Supports(scan_types)) {
+        result->rowset = make_uniq<OdbcRowset>(scan_types, bind_data.options.batch_size, bind_data.options.encoding,
+                                               bind_data.options.max_lob_size, bind_data.options.lob_overflow_null);
+        result->rowset->SetBufferBudget(OdbcRowset::GetBufferBudget(context.client),
+                                        bind_data.options.adaptive_batch_size);
+    } else {
+        if (OdbcEncoding::NeedsConversion(bind_data.options.encoding)) {
+            result->encoding_converter = make_uniq<OdbcEncodingConverter>(bind_data.options.encoding);
+        }
+        result->long_columns = CreateLongColumnBuffers(scan_types, bind_data.options,
+                                                       result->encoding_converter.get());
+    }
+    
+    // The first thread returns the cached rows, every thread collects what it reads
+    if (gstate.result_cache) {
+        lock_guard<mutex> guard(gstate.lock);
+        if (gstate.cached_result && !gstate.cached_result_claimed) {
+            gstate.cached_result_claimed = true;
+            result->cached_rows = gstate.cached_result;
+            if (!result->cached_rows->segments.empty()) {
+                result->cached_rows->segments[0]->InitializeScan(result->cached_scan);
+            }
+        }
+        if (gstate.cache_store) {
+            gstate.cache_threads++;
+            result->cache_rows = make_uniq<ColumnDataCollection>(Allocator::DefaultAllocator(), scan_types);
+            result->cache_rows->InitializeAppend(result->cache_append);
         }
-        
-        // Prepare the statement
-        result->statement = result->connection->Prepare(sql);
-        result->done = false;
-    } catch (const nanodbc::database_error& e) {
-        OdbcUtils::ThrowException("initialize scanner", e);
+    }
+    
+    // Each thread opens its own connection and starts on the next free range
+    result->done = !StartNextPartition(context.client, bind_data, gstate, *result);
+    
+    // Fetch ahead on a background thread so that driver round trips overlap with
+    // the rest of the pipeline. The connection is already open, so the fetcher
+    // only needs the context if a later range had to connect (it never does).
+    auto prefetch_depth = OdbcPrefetcher::GetDepth(context.client);
+    if (!result->done && prefetch_depth > 0) {
+        auto &client = context.client;
+        auto state = result.get();
+        result->prefetcher = make_uniq<OdbcPrefetcher>(scan_types, prefetch_depth,
+            [&client, &bind_data, &gstate, state](DataChunk &chunk) {
+                ScanOdbcChunk(client, bind_data, gstate, *state, chunk);
+                return !state->done;
+            });
     }
     
     return std::move(result);
@@ -297,12 +1011,181 @@ unique_ptr<LocalTableFunctionState> InitOdbcLocalState(ExecutionContext &context
 // Scan Function
 //------------------------------------------------------------------------------
 
+// Fill the chunk column by column from bound rowsets. A rowset can span chunk
+// boundaries, in which case the remaining rows are served by the next call.
+static idx_t ScanBoundRowsets(ClientContext &context, const OdbcScannerState &bind_data, 
+                              OdbcGlobalScanState &gstate, OdbcLocalScanState &state, DataChunk &output) {
+    idx_t out_idx = 0;
+    while (out_idx < STANDARD_VECTOR_SIZE) {
+        if (state.rowset_offset >= state.rowset_count) {
+            if (!state.rowset_bound) {
+                OdbcScopedTimer timer(state.metrics.execute_ns);
+                OdbcCancelGuard cancel(context, state.statement->GetNativeHandle(), bind_data.options.query_timeout,
+                                       "query_timeout");
+                try {
+                    state.statement->Execute();
+                } catch (...) {
+                    cancel.ThrowIfCancelled();
+                    throw;
+                }
+                state.rowset->Bind(*state.statement, state.connection->GetDriverInfo());
+                state.rowset_bound = true;
+            }
+            
+            {
+                OdbcScopedTimer timer(state.metrics.fetch_ns);
+                OdbcCancelGuard cancel(context, state.statement->GetNativeHandle(), bind_data.options.fetch_timeout,
+                                       "fetch_timeout");
+                try {
+                    state.rowset_count = state.rowset->Fetch();
+                } catch (...) {
+                    cancel.ThrowIfCancelled();
+                    throw;
+                }
+            }
+            state.rowset_offset = 0;
+            if (state.rowset_count > 0) {
+                state.metrics.rowsets++;
+                if (state.metrics.first_row_ns == 0) {
+                    state.metrics.first_row_ns = state.scan_timer.ElapsedNanos();
+                }
+            }
+            if (state.rowset_count == 0) {
+                // Current range is exhausted - continue with the next one, if any
+                if (!StartNextPartition(context, bind_data, gstate, state)) {
+                    state.done = true;
+                    break;
+                }
+                continue;
+            }
+        }
+        
+        idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE - out_idx, state.rowset_count - state.rowset_offset);
+        state.rowset->Scan(output, state.rowset_offset, count, out_idx, &state.metrics);
+        state.rowset_offset += count;
+        state.metrics.rows += count;
+        out_idx += count;
+    }
+    return out_idx;
+}
+
+// Take the next chunk from the background fetcher, or fetch it on this thread
+static void FetchOdbcChunk(ClientContext &context, const OdbcScannerState &bind_data, OdbcGlobalScanState &gstate,
+                           OdbcLocalScanState &state, DataChunk &output) {
+    if (!state.prefetcher) {
+        ScanOdbcChunk(context, bind_data, gstate, state, output);
+        return;
+    }
+    
+    state.prefetched_chunk = state.prefetcher->Next();
+    if (!state.prefetched_chunk) {
+        // The fetcher has finished, the scan state is ours again
+        state.prefetcher.reset();
+        state.done = true;
+        output.SetCardinality(0);
+        return;
+    }
+    output.Reference(*state.prefetched_chunk);
+}
+
+OdbcLocalScanState::~OdbcLocalScanState() {
+    // The fetcher updates the metrics, so it has to stop first
+    prefetcher.reset();
+    // Keep the prepared query for the next execution on this connection
+    if (statement && connection) {
+        try {
+            if (rowset) {
+                rowset->Unbind();
+            }
+            connection->ReleaseStatement(std::move(statement));
+        } catch (...) {
+            // The statement is closed with the state instead
+        }
+    }
+    if (stats_registry) {
+        stats_registry->Merge(scan_id, metrics);
+    }
+}
+
+// True once all rows have been returned (the fetch state is only read after the fetcher stopped)
+static bool IsScanDone(const OdbcLocalScanState &state) {
+    return !state.prefetcher && state.done && !state.cached_rows;
+}
+
+// Return the next chunk of the cached result, false once it is exhausted
+static bool ScanCachedRows(OdbcLocalScanState &state, DataChunk &output) {
+    auto &segments = state.cached_rows->segments;
+    while (state.cached_segment < segments.size()) {
+        if (segments[state.cached_segment]->Scan(state.cached_scan, output)) {
+            return true;
+        }
+        if (++state.cached_segment < segments.size()) {
+            segments[state.cached_segment]->InitializeScan(state.cached_scan);
+        }
+    }
+    state.cached_rows.reset();
+    return false;
+}
+
+// Hand the rows this thread read to the global state. The last thread to finish
+// stores the result, after the rows of a refreshed result.
+static void FinishCaching(OdbcGlobalScanState &gstate, OdbcLocalScanState &state) {
+    if (!state.cache_rows) {
+        return;
+    }
+    auto types = state.cache_rows->Types();
+    std::shared_ptr<ColumnDataCollection> rows(std::move(state.cache_rows));
+    
+    lock_guard<mutex> guard(gstate.lock);
+    if (rows->Count() > 0) {
+        gstate.cache_segments.push_back(std::move(rows));
+    }
+    if (--gstate.cache_threads > 0 || gstate.position < gstate.partitions.size() || !gstate.cache_store) {
+        return;
+    }
+    auto result = std::make_shared<OdbcCachedResult>();
+    result->types = std::move(types);
+    if (gstate.cached_result) {
+        result->segments = gstate.cached_result->segments;
+    }
+    for (auto &segment : gstate.cache_segments) {
+        result->segments.push_back(segment);
+    }
+    result->watermark = gstate.cache_watermark;
+    gstate.result_cache->Store(gstate.cache_key, std::move(result));
+    gstate.cache_store = false;
+}
+
+// Next chunk of the scan: the cached rows first, then rows of the source, which are
+// collected for the result cache
+static void NextOdbcChunk(ClientContext &context, const OdbcScannerState &bind_data, OdbcGlobalScanState &gstate,
+                          OdbcLocalScanState &state, DataChunk &output) {
+    if (state.cached_rows && ScanCachedRows(state, output)) {
+        return;
+    }
+    if (IsScanDone(state)) {
+        // Nothing to read from the source
+        output.SetCardinality(0);
+        FinishCaching(gstate, state);
+        return;
+    }
+    FetchOdbcChunk(context, bind_data, gstate, state, output);
+    if (state.cache_rows && output.size() > 0) {
+        state.cache_rows->Append(state.cache_append, output);
+    }
+    if (IsScanDone(state)) {
+        FinishCaching(gstate, state);
+    }
+}
+
 void ScanOdbcSource(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &state = data.local_state->Cast<OdbcLocalScanState>();
+    auto &gstate = data.global_state->Cast<OdbcGlobalScanState>();
     auto &bind_data = data.bind_data->Cast<OdbcScannerState>();
     
-    if (state.done) {
+    if (IsScanDone(state)) {
         output.SetCardinality(0);
+        FinishCaching(gstate, state);
         return;
     }
 
@@ -317,149 +1200,357 @@ void ScanOdbcSource(ClientContext &context, TableFunctionInput &data, DataChunk
         return;
     }
     
-    // Fetch rows and populate the DataChunk
+    if (!state.filter_executor) {
+        NextOdbcChunk(context, bind_data, gstate, state, output);
+        return;
+    }
+    
+    // Apply the filters that were not pushed down; an empty chunk would end the
+    // scan, so keep fetching until rows pass or the result is exhausted
+    while (true) {
+        output.Reset();
+        NextOdbcChunk(context, bind_data, gstate, state, output);
+        auto count = state.filter_executor->SelectExpression(output, state.filter_sel);
+        if (count < output.size()) {
+            output.Slice(state.filter_sel, count);
+        }
+        if (count > 0 || IsScanDone(state)) {
+            break;
+        }
+    }
+}
+
+std::vector<OdbcColumnBuffer> CreateLongColumnBuffers(const vector<LogicalType> &types, const OdbcOptions &options,
+                                                      OdbcEncodingConverter *encoding_converter) {
+    std::vector<OdbcColumnBuffer> long_columns(types.size());
+    for (idx_t i = 0; i < types.size(); i++) {
+        auto &column = long_columns[i];
+        column.c_type = types[i].id() == LogicalTypeId::BLOB ? SQL_C_BINARY : SQL_C_CHAR;
+        if (types[i].id() == LogicalTypeId::VARCHAR) {
+            column.encoding = encoding_converter;
+        }
+        column.max_lob_size = options.max_lob_size;
+        column.lob_overflow_null = options.lob_overflow_null;
+    }
+    return long_columns;
+}
+
+// Character value of the current row as held in the result's rowset buffer. Narrow data
+// is returned in place; wide data is narrowed into the column's scratch text, which only
+// holds for ASCII values (numbers, UUIDs). Values longer than the bound buffer are read
+// again with SQLGetData, anything else is read through nanodbc into the scratch text, so
+// no value allocates once the scratch buffer has grown to fit.
+static void GetRowText(OdbcStatement &statement, idx_t col_idx, OdbcColumnBuffer &column, const char *&data,
+                       idx_t &length) {
+    SQLSMALLINT c_type;
+    SQLLEN indicator;
+    SQLLEN capacity;
+    auto bound = statement.GetBoundData(col_idx, c_type, indicator, capacity);
+    if (bound && (c_type == SQL_C_CHAR || c_type == SQL_C_WCHAR) &&
+        (indicator == SQL_NO_TOTAL || indicator >= capacity)) {
+        // The buffer only holds the start of the value (the length comes from the indicator,
+        // never from the terminator, so embedded zeros are kept)
+        statement.GetDataString(col_idx, c_type, column.text);
+        data = column.text.data();
+        length = column.text.size();
+        return;
+    }
+    if (bound && c_type == SQL_C_CHAR && indicator >= 0) {
+        data = bound;
+        length = static_cast<idx_t>(indicator);
+        return;
+    }
+    if (bound && c_type == SQL_C_WCHAR && indicator >= 0) {
+        auto wide = reinterpret_cast<const odbc_wide_unit_t *>(bound);
+        auto count = static_cast<idx_t>(indicator) / sizeof(SQLWCHAR);
+        column.text.resize(count);
+        bool ascii = true;
+        for (idx_t i = 0; i < count && ascii; i++) {
+            ascii = wide[i] < 0x80;
+            column.text[i] = static_cast<char>(wide[i]);
+        }
+        if (ascii) {
+            data = column.text.data();
+            length = count;
+            return;
+        }
+    }
+    statement.GetString(col_idx, column.text);
+    data = column.text.data();
+    length = column.text.size();
+}
+
+void ConvertRowValue(OdbcStatement &statement, OdbcEncodingConverter *encoding_converter,
+                     std::vector<OdbcColumnBuffer> &long_columns, idx_t col_idx, Vector &out_vec, idx_t out_idx) {
+    auto type_id = out_vec.GetType().id();
+    
+    // Long-data columns are streamed in chunks instead of being materialised by nanodbc
+    if ((type_id == LogicalTypeId::VARCHAR || type_id == LogicalTypeId::BLOB) && !statement.IsBound(col_idx)) {
+        OdbcRowset::ReadLongColumn(statement.GetNativeHandle(), static_cast<SQLUSMALLINT>(col_idx + 1),
+                                   long_columns[col_idx], out_vec, out_idx);
+        return;
+    }
+    
+    // Check for NULL
+    if (statement.IsNull(col_idx)) {
+        FlatVector::Validity(out_vec).Set(out_idx, false);
+        return;
+    }
+    
+    // Based on the output vector type, convert and fetch the data
+    switch (out_vec.GetType().id()) {
+        case LogicalTypeId::VARCHAR: {
+            auto &column = long_columns[col_idx];
+            // Wide values are transcoded from the result's buffer straight into the vector
+            SQLSMALLINT c_type;
+            SQLLEN indicator;
+            SQLLEN capacity;
+            auto bound = statement.GetBoundData(col_idx, c_type, indicator, capacity);
+            if (bound && c_type == SQL_C_WCHAR && indicator >= 0 && indicator < capacity) {
+                bool over_limit;
+                FlatVector::GetData<string_t>(out_vec)[out_idx] = OdbcEncoding::WideToVector(
+                    out_vec, reinterpret_cast<const odbc_wide_unit_t *>(bound),
+                    static_cast<idx_t>(indicator) / sizeof(SQLWCHAR), column.max_lob_size, over_limit);
+                if (over_limit && column.lob_overflow_null) {
+                    FlatVector::Validity(out_vec).Set(out_idx, false);
+                }
+                break;
+            }
+            const char *data;
+            idx_t length;
+            GetRowText(statement, col_idx, column, data, length);
+            if (!OdbcRowset::LimitLongValue(column, data, length)) {
+                FlatVector::Validity(out_vec).Set(out_idx, false);
+                break;
+            }
+            // Apply encoding conversion if needed
+            if (encoding_converter) {
+                FlatVector::GetData<string_t>(out_vec)[out_idx] = 
+                    encoding_converter->ConvertToVector(out_vec, data, length);
+                break;
+            }
+            OdbcEncoding::VerifyUtf8(data, length);
+            FlatVector::GetData<string_t>(out_vec)[out_idx] = StringVector::AddString(out_vec, data, length);
+            break;
+        }
+        
+        case LogicalTypeId::BOOLEAN:
+            FlatVector::GetData<bool>(out_vec)[out_idx] = (statement.GetInt32(col_idx) != 0);
+            break;
+            
+        case LogicalTypeId::TINYINT:
+            FlatVector::GetData<int8_t>(out_vec)[out_idx] = static_cast<int8_t>(statement.GetInt32(col_idx));
+            break;
+            
+        case LogicalTypeId::SMALLINT:
+            FlatVector::GetData<int16_t>(out_vec)[out_idx] = static_cast<int16_t>(statement.GetInt32(col_idx));
+            break;
+            
+        case LogicalTypeId::INTEGER:
+            FlatVector::GetData<int32_t>(out_vec)[out_idx] = statement.GetInt32(col_idx);
+            break;
+            
+        case LogicalTypeId::BIGINT:
+            FlatVector::GetData<int64_t>(out_vec)[out_idx] = statement.GetInt64(col_idx);
+            break;
+            
+        case LogicalTypeId::FLOAT:
+            FlatVector::GetData<float>(out_vec)[out_idx] = static_cast<float>(statement.GetDouble(col_idx));
+            break;
+            
+        case LogicalTypeId::DOUBLE:
+            FlatVector::GetData<double>(out_vec)[out_idx] = statement.GetDouble(col_idx);
+            break;
+            
+        case LogicalTypeId::DECIMAL: {
+            // Parse the text form exactly instead of going through double
+            const char *data;
+            idx_t length;
+            GetRowText(statement, col_idx, long_columns[col_idx], data, length);
+            if (!OdbcUtils::ParseDecimal(data, length, out_vec, out_idx)) {
+                auto &decimal_type = out_vec.GetType();
+                throw InvalidInputException("Could not convert \"%s\" to %s", std::string(data, length),
+                                            decimal_type.ToString());
+            }
+            break;
+        }
+        
+        case LogicalTypeId::DATE: {
+            FlatVector::GetData<date_t>(out_vec)[out_idx] = statement.GetDate(col_idx);
+            break;
+        }
+        
+        case LogicalTypeId::TIME: {
+            FlatVector::GetData<dtime_t>(out_vec)[out_idx] = statement.GetTime(col_idx);
+            break;
+        }
+        
+        case LogicalTypeId::TIMESTAMP: {
+            FlatVector::GetData<timestamp_t>(out_vec)[out_idx] = statement.GetTimestamp(col_idx);
+            break;
+        }
+        
+        case LogicalTypeId::TIMESTAMP_TZ: {
+            // nanodbc reads DATETIMEOFFSET as text with its UTC offset
+            const char *data;
+            idx_t length;
+            GetRowText(statement, col_idx, long_columns[col_idx], data, length);
+            FlatVector::GetData<timestamp_t>(out_vec)[out_idx] = Timestamp::FromCString(data, length);
+            break;
+        }
+        
+        case LogicalTypeId::UUID: {
+            auto &column = long_columns[col_idx];
+            const char *data;
+            idx_t length;
+            GetRowText(statement, col_idx, column, data, length);
+            if (data != column.text.data()) {
+                column.text.assign(data, length);
+            }
+            try {
+                hugeint_t uuidValue;
+                if (UUID::FromString(column.text, uuidValue)) {
+                    FlatVector::GetData<hugeint_t>(out_vec)[out_idx] = uuidValue;
+                } else {
+                    FlatVector::Validity(out_vec).Set(out_idx, false);
+                }
+            } catch (...) {
+                FlatVector::Validity(out_vec).Set(out_idx, false);
+            }
+            break;
+        }
+        
+        case LogicalTypeId::BLOB: {
+            auto &column = long_columns[col_idx];
+            statement.GetString(col_idx, column.text);
+            idx_t length = column.text.size();
+            if (!OdbcRowset::LimitLongValue(column, column.text.data(), length)) {
+                FlatVector::Validity(out_vec).Set(out_idx, false);
+                break;
+            }
+            FlatVector::GetData<string_t>(out_vec)[out_idx] = 
+                StringVector::AddStringOrBlob(out_vec, column.text.data(), length);
+            break;
+        }
+        
+        default:
+            throw BinderException("Unsupported ODBC to DuckDB type conversion: " + 
+                               out_vec.GetType().ToString());
+    }
+}
+
+// Conversion time of the row-by-row path is measured on every n-th row and scaled up
+static constexpr idx_t ROW_CONVERT_SAMPLE_INTERVAL = 64;
+
+// Fill the chunk with the next rows of the current scan
+static void ScanOdbcChunk(ClientContext &context, const OdbcScannerState &bind_data, OdbcGlobalScanState &gstate,
+                          OdbcLocalScanState &state, DataChunk &output) {
+    auto &metrics = state.metrics;
+    if (state.rowset) {
+        output.SetCardinality(ScanBoundRowsets(context, bind_data, gstate, state, output));
+        metrics.AddBytes(output);
+        return;
+    }
+    
+    // Fetch rows and populate the DataChunk. Rows are served from the rowset
+    // buffer of the block cursor, so the driver is only hit once per batch_size rows.
     idx_t out_idx = 0;
     while (out_idx < STANDARD_VECTOR_SIZE) {
-        if (!state.statement->Step()) {
-            state.done = true;
-            break;
+        bool has_row;
+        if (state.statement_rows % state.statement->GetRowsetSize() == 0) {
+            // The first step executes the statement, every rowset_size-th one fetches the
+            // next rowset; only those go to the driver and can block
+            bool executed = state.statement->IsExecuted();
+            OdbcScopedTimer timer(executed ? metrics.fetch_ns : metrics.execute_ns);
+            OdbcCancelGuard cancel(context, state.statement->GetNativeHandle(),
+                                   executed ? bind_data.options.fetch_timeout : bind_data.options.query_timeout,
+                                   executed ? "fetch_timeout" : "query_timeout");
+            try {
+                has_row = state.statement->Step();
+            } catch (...) {
+                cancel.ThrowIfCancelled();
+                throw;
+            }
+        } else {
+            OdbcScopedTimer timer(metrics.fetch_ns);
+            has_row = state.statement->Step();
+        }
+        if (!has_row) {
+            // Current range is exhausted - continue with the next one, if any
+            if (!StartNextPartition(context, bind_data, gstate, state)) {
+                state.done = true;
+                break;
+            }
+            continue;
+        }
+        if (state.statement_rows++ % state.statement->GetRowsetSize() == 0) {
+            metrics.rowsets++;
         }
-        state.scan_count++;
+        if (metrics.first_row_ns == 0) {
+            metrics.first_row_ns = state.scan_timer.ElapsedNanos();
+        }
+        metrics.rows++;
         
         // Process each column
+        bool sample = metrics.rows % ROW_CONVERT_SAMPLE_INTERVAL == 0;
         for (idx_t col_idx = 0; col_idx < output.ColumnCount(); col_idx++) {
             auto &out_vec = output.data[col_idx];
-            
-            // Check for NULL
-            if (state.statement->IsNull(col_idx)) {
-                FlatVector::Validity(out_vec).Set(out_idx, false);
+            if (!sample) {
+                ConvertRowValue(*state.statement, state.encoding_converter.get(), state.long_columns, col_idx,
+                                out_vec, out_idx);
                 continue;
             }
-            
-            // Based on the output vector type, convert and fetch the data
-            switch (out_vec.GetType().id()) {
-                case LogicalTypeId::VARCHAR: {
-                    std::string str_val = state.statement->GetString(col_idx);
-                    // Apply encoding conversion if needed
-                    if (OdbcEncoding::NeedsConversion(bind_data.options.encoding)) {
-                        str_val = OdbcEncoding::ConvertToUTF8(str_val, bind_data.options.encoding);
-                    }
-                    FlatVector::GetData<string_t>(out_vec)[out_idx] = 
-                        StringVector::AddString(out_vec, str_val);
-                    break;
-                }
-                
-                case LogicalTypeId::BOOLEAN:
-                    FlatVector::GetData<bool>(out_vec)[out_idx] = (state.statement->GetInt32(col_idx) != 0);
-                    break;
-                    
-                case LogicalTypeId::TINYINT:
-                    FlatVector::GetData<int8_t>(out_vec)[out_idx] = static_cast<int8_t>(state.statement->GetInt32(col_idx));
-                    break;
-                    
-                case LogicalTypeId::SMALLINT:
-                    FlatVector::GetData<int16_t>(out_vec)[out_idx] = static_cast<int16_t>(state.statement->GetInt32(col_idx));
-                    break;
-                    
-                case LogicalTypeId::INTEGER:
-                    FlatVector::GetData<int32_t>(out_vec)[out_idx] = state.statement->GetInt32(col_idx);
-                    break;
-                    
-                case LogicalTypeId::BIGINT:
-                    FlatVector::GetData<int64_t>(out_vec)[out_idx] = state.statement->GetInt64(col_idx);
-                    break;
-                    
-                case LogicalTypeId::FLOAT:
-                    FlatVector::GetData<float>(out_vec)[out_idx] = static_cast<float>(state.statement->GetDouble(col_idx));
-                    break;
-                    
-                case LogicalTypeId::DOUBLE:
-                    FlatVector::GetData<double>(out_vec)[out_idx] = state.statement->GetDouble(col_idx);
-                    break;
-                    
-                case LogicalTypeId::DECIMAL: {
-                    auto &decimal_type = out_vec.GetType();
-                    uint8_t width = DecimalType::GetWidth(decimal_type);
-                    uint8_t scale = DecimalType::GetScale(decimal_type);
-                    
-                    double decimal_val = state.statement->GetDouble(col_idx);
-                    double scaled_val = decimal_val * pow(10, scale);
-                    
-                    switch (decimal_type.InternalType()) {
-                        case PhysicalType::INT16:
-                            FlatVector::GetData<int16_t>(out_vec)[out_idx] = (int16_t)round(scaled_val);
-                            break;
-                        case PhysicalType::INT32:
-                            FlatVector::GetData<int32_t>(out_vec)[out_idx] = (int32_t)round(scaled_val);
-                            break;
-                        case PhysicalType::INT64:
-                            FlatVector::GetData<int64_t>(out_vec)[out_idx] = (int64_t)round(scaled_val);
-                            break;
-                        case PhysicalType::INT128:
-                            FlatVector::GetData<hugeint_t>(out_vec)[out_idx] = (hugeint_t)round(scaled_val);
-                            break;
-                        default:
-                            FlatVector::Validity(out_vec).Set(out_idx, false);
-                            break;
-                    }
-                    break;
-                }
-                
-                case LogicalTypeId::DATE: {
-                    timestamp_t ts = state.statement->GetTimestamp(col_idx);
-                    FlatVector::GetData<date_t>(out_vec)[out_idx] = Timestamp::GetDate(ts);
-                    break;
-                }
-                
-                case LogicalTypeId::TIME: {
-                    timestamp_t ts = state.statement->GetTimestamp(col_idx);
-                    FlatVector::GetData<dtime_t>(out_vec)[out_idx] = Timestamp::GetTime(ts);
-                    break;
-                }
-                
-                case LogicalTypeId::TIMESTAMP: {
-                    FlatVector::GetData<timestamp_t>(out_vec)[out_idx] = state.statement->GetTimestamp(col_idx);
-                    break;
-                }
-                
-                case LogicalTypeId::UUID: {
-                    std::string uuidStr = state.statement->GetString(col_idx);
-                    try {
-                        hugeint_t uuidValue;
-                        if (UUID::FromString(uuidStr, uuidValue)) {
-                            FlatVector::GetData<hugeint_t>(out_vec)[out_idx] = uuidValue;
-                        } else {
-                            FlatVector::Validity(out_vec).Set(out_idx, false);
-                        }
-                    } catch (...) {
-                        FlatVector::Validity(out_vec).Set(out_idx, false);
-                    }
-                    break;
-                }
-                
-                case LogicalTypeId::BLOB: {
-                    std::string blob_data = state.statement->GetString(col_idx);
-                    FlatVector::GetData<string_t>(out_vec)[out_idx] = 
-                        StringVector::AddStringOrBlob(out_vec, blob_data.data(), blob_data.size());
-                    break;
-                }
-                
-                default:
-                    throw BinderException("Unsupported ODBC to DuckDB type conversion: " + 
-                                       out_vec.GetType().ToString());
-            }
+            OdbcScanTimer timer;
+            ConvertRowValue(*state.statement, state.encoding_converter.get(), state.long_columns, col_idx,
+                            out_vec, out_idx);
+            auto type_class = OdbcScanMetrics::GetTypeClass(out_vec.GetType());
+            metrics.convert_ns[static_cast<idx_t>(type_class)] += timer.ElapsedNanos() * ROW_CONVERT_SAMPLE_INTERVAL;
         }
         
         out_idx++;
     }
     
     output.SetCardinality(out_idx);
+    metrics.AddBytes(output);
 }
 
 //------------------------------------------------------------------------------
 // Attach Function
 //------------------------------------------------------------------------------
 
+// Named parameters shared by the odbc_scan and odbc_query calls of the attached views
+static named_parameter_map_t AttachViewParameters(const OdbcAttachFunctionData &attach_data) {
+    named_parameter_map_t params;
+    params["connection"] = Value(attach_data.connection_params.GetDsn().empty() ? 
+                               attach_data.connection_params.GetConnectionString() : 
+                               attach_data.connection_params.GetDsn());
+    
+    if (!attach_data.connection_params.GetUsername().empty()) {
+        params["username"] = Value(attach_data.connection_params.GetUsername());
+        
+        if (!attach_data.connection_params.GetPassword().empty()) {
+            params["password"] = Value(attach_data.connection_params.GetPassword());
+        }
+    }
+    
+    if (attach_data.options.all_varchar) {
+        params["all_varchar"] = Value::BOOLEAN(true);
+    }
+    
+    if (OdbcEncoding::NeedsConversion(attach_data.options.encoding)) {
+        params["encoding"] = Value(attach_data.options.encoding);
+    }
+    
+    if (!attach_data.options.filter_pushdown) {
+        params["filter_pushdown"] = Value::BOOLEAN(false);
+    }
+    
+    if (attach_data.options.cache) {
+        params["cache"] = Value::BOOLEAN(true);
+    }
+    return params;
+}
+
 void AttachOdbcDatabase(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &attach_data = data.bind_data->CastNoConst<OdbcAttachFunctionData>();
     
@@ -469,63 +1560,76 @@ void AttachOdbcDatabase(ClientContext &context, TableFunctionInput &data, DataCh
     }
     
     try {
-        auto db = OdbcConnection::Connect(attach_data.connection_params);
+        auto db = OdbcConnectionPool::Acquire(context, attach_data.connection_params);
         auto dconn = Connection(context.db->GetDatabase(context));
         
+        std::vector<std::string> tables;
+        std::vector<std::string> views;
+        db->GetTablesAndViews(tables, views);
+        
+        // The views bind with the connection parameters they are created with, which leave
+        // timeout, read_only and isolation at their defaults
+        auto base_params = AttachViewParameters(attach_data);
+        auto &username = attach_data.connection_params.GetUsername();
+        ConnectionParams view_connection(base_params["connection"].GetValue<string>(), username,
+                                         username.empty() ? std::string() : attach_data.connection_params.GetPassword());
+        
+        // Read the columns of all tables and views with one SQLColumns call and put them in the
+        // schema cache, so that creating each view does not need catalog round trips of its own.
+        // Row counts are left to the first query that plans a scan of the table.
+        auto schema_cache = OdbcSchemaCache::Get(context);
+        std::string dbms_name;
+        try {
+            dbms_name = db->GetNativeConnection().dbms_name();
+        } catch (const nanodbc::database_error&) {
+            // Unknown DBMS - dialect specific pushdown stays off
+        }
+        std::unordered_map<std::string, OdbcSchema> schemas;
+        for (auto &table : db->GetColumns(std::string(), std::string(), attach_data.options.all_varchar)) {
+            // A name that exists in several schemas resolves to the first one, as in GetTableInfo
+            if (table.columns.empty() || schemas.count(table.name)) {
+                continue;
+            }
+            auto &schema = schemas[table.name];
+            for (auto &column : table.columns) {
+                schema.names.push_back(column.name);
+                schema.types.push_back(column.type);
+            }
+            schema.dbms_name = dbms_name;
+            schema.cardinality_estimated = false;
+        }
+        
         // Handle tables
-        auto tables = db->GetTables();
         for (auto &table_name : tables) {
-            // Build named parameters map
-            duckdb::named_parameter_map_t params;
-            params["connection"] = Value(attach_data.connection_params.GetDsn().empty() ? 
-                                       attach_data.connection_params.GetConnectionString() : 
-                                       attach_data.connection_params.GetDsn());
-            params["table_name"] = Value(table_name);
-            
-            if (!attach_data.connection_params.GetUsername().empty()) {
-                params["username"] = Value(attach_data.connection_params.GetUsername());
-                
-                if (!attach_data.connection_params.GetPassword().empty()) {
-                    params["password"] = Value(attach_data.connection_params.GetPassword());
-                }
-            }
-            
-            if (attach_data.options.all_varchar) {
-                params["all_varchar"] = Value::BOOLEAN(true);
+            auto entry = schemas.find(table_name);
+            if (entry != schemas.end()) {
+                schema_cache->Store(OdbcSchemaCache::TableKey(view_connection, table_name,
+                                                              attach_data.options.all_varchar),
+                                    entry->second);
             }
             
-            if (OdbcEncoding::NeedsConversion(attach_data.options.encoding)) {
-                params["encoding"] = Value(attach_data.options.encoding);
-            }
+            auto params = base_params;
+            params["table_name"] = Value(table_name);
             
             auto table_func_relation = dconn.TableFunction("odbc_scan", {}, params);
             table_func_relation->CreateView(table_name, attach_data.options.overwrite, false);
         }
         
         // Handle views
-        auto views = db->GetViews();
         for (auto &view_name : views) {
-            duckdb::named_parameter_map_t params;
-            params["connection"] = Value(attach_data.connection_params.GetDsn().empty() ? 
-                                       attach_data.connection_params.GetConnectionString() : 
-                                       attach_data.connection_params.GetDsn());
-            params["query"] = Value("SELECT * FROM \"" + OdbcUtils::SanitizeString(view_name) + "\"");
-            
-            if (!attach_data.connection_params.GetUsername().empty()) {
-                params["username"] = Value(attach_data.connection_params.GetUsername());
-                
-                if (!attach_data.connection_params.GetPassword().empty()) {
-                    params["password"] = Value(attach_data.connection_params.GetPassword());
-                }
+            auto query = "SELECT * FROM \"" + OdbcUtils::SanitizeString(view_name) + "\"";
+            auto entry = schemas.find(view_name);
+            if (entry != schemas.end()) {
+                OdbcSchema schema;
+                schema.names = entry->second.names;
+                schema.types = entry->second.types;
+                schema_cache->Store(OdbcSchemaCache::QueryKey(view_connection, query, attach_data.options.all_varchar),
+                                    std::move(schema));
             }
             
-            if (attach_data.options.all_varchar) {
-                params["all_varchar"] = Value::BOOLEAN(true);
-            }
-            
-            if (OdbcEncoding::NeedsConversion(attach_data.options.encoding)) {
-                params["encoding"] = Value(attach_data.options.encoding);
-            }
+            auto params = base_params;
+            params.erase("filter_pushdown");
+            params["query"] = Value(query);
             
             auto query_func_relation = dconn.TableFunction("odbc_query", {}, params);
             query_func_relation->CreateView(view_name, attach_data.options.overwrite, false);
@@ -546,26 +1650,68 @@ void AttachOdbcDatabase(ClientContext &context, TableFunctionInput &data, DataCh
 // Exec Function
 //------------------------------------------------------------------------------
 
+unique_ptr<GlobalTableFunctionState> InitOdbcExecState(ClientContext &context, TableFunctionInitInput &input) {
+    return make_uniq<OdbcExecGlobalState>();
+}
+
 void ExecuteOdbcStatement(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-    auto &exec_data = data.bind_data->CastNoConst<OdbcExecFunctionData>();
+    auto &exec_data = data.bind_data->Cast<OdbcExecFunctionData>();
+    auto &state = data.global_state->Cast<OdbcExecGlobalState>();
     
-    if (exec_data.finished) {
+    if (state.position >= exec_data.statements.size()) {
         output.SetCardinality(0);
         return;
     }
     
     try {
-        auto db = OdbcConnection::Connect(exec_data.connection_params);
-        db->Execute(exec_data.sql);
-        
-        output.SetCardinality(1);
-        FlatVector::GetData<bool>(output.data[0])[0] = true;
-        
-        exec_data.finished = true;
-        
+        if (!state.connection) {
+            state.connection = OdbcConnectionPool::Acquire(context, exec_data.connection_params);
+            if (exec_data.transaction) {
+                state.transaction = make_uniq<nanodbc::transaction>(state.connection->GetNativeConnection());
+            }
+        }
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("execute statement", e);
     }
+    
+    auto success = FlatVector::GetData<bool>(output.data[0]);
+    auto index = FlatVector::GetData<int32_t>(output.data[1]);
+    auto rows_affected = FlatVector::GetData<int64_t>(output.data[2]);
+    idx_t count = 0;
+    try {
+        while (count < STANDARD_VECTOR_SIZE && state.position < exec_data.statements.size()) {
+            auto rows = state.connection->Execute(context, exec_data.statements[state.position],
+                                                  exec_data.options.query_timeout);
+            success[count] = true;
+            index[count] = static_cast<int32_t>(state.position + 1);
+            if (rows < 0) {
+                FlatVector::SetNull(output.data[2], count, true);
+            } else {
+                rows_affected[count] = rows;
+            }
+            count++;
+            state.position++;
+        }
+    } catch (...) {
+        // Statements before the failing one may have changed remote tables (unless rolled back)
+        OdbcSchemaCache::Get(context)->Clear();
+        OdbcResultCache::Get(context)->Clear();
+        throw;
+    }
+    
+    // The statements may have changed remote tables
+    OdbcSchemaCache::Get(context)->Clear();
+    OdbcResultCache::Get(context)->Clear();
+    
+    if (state.position == exec_data.statements.size() && state.transaction) {
+        try {
+            state.transaction->commit();
+            state.transaction.reset();
+        } catch (const nanodbc::database_error& e) {
+            OdbcUtils::ThrowException("commit transaction", e);
+        }
+    }
+    output.SetCardinality(count);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+#include "odbc_schema_cache.hpp"
+#include "odbc_result_cache.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+namespace duckdb {
+
+std::shared_ptr<OdbcSchemaCache> OdbcSchemaCache::Get(ClientContext &context) {
+    auto cache = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcSchemaCache>(ObjectType());
+    Value value;
+    if (context.TryGetCurrentSetting("odbc_schema_cache_ttl", value) && !value.IsNull()) {
+        cache->SetTTL(value.GetValue<uint64_t>());
+    }
+    return cache;
+}
+
+void OdbcSchemaCache::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_schema_cache_ttl",
+                              "Seconds the column list of an ODBC table or query is cached for binding (0 disables caching)",
+                              LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_TTL_SECONDS));
+}
+
+std::string OdbcSchemaCache::TableKey(const ConnectionParams &params, const std::string &table_name, bool all_varchar) {
+    return params.GetKey() + '\x1e' + "table" + '\x1e' + (all_varchar ? "varchar" : "typed") + '\x1e' + table_name;
+}
+
+std::string OdbcSchemaCache::QueryKey(const ConnectionParams &params, const std::string &query, bool all_varchar) {
+    return params.GetKey() + '\x1e' + "query" + '\x1e' + (all_varchar ? "varchar" : "typed") + '\x1e' + query;
+}
+
+template <class T>
+bool OdbcSchemaCache::LookupEntry(std::unordered_map<std::string, CachedEntry<T>> &map, const std::string &key,
+                                  T &value) {
+    lock_guard<mutex> guard(lock);
+    if (ttl_seconds == 0) {
+        return false;
+    }
+    auto entry = map.find(key);
+    if (entry == map.end()) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() - entry->second.stored > std::chrono::seconds(ttl_seconds)) {
+        map.erase(entry);
+        return false;
+    }
+    value = entry->second.value;
+    return true;
+}
+
+template <class T>
+void OdbcSchemaCache::StoreEntry(std::unordered_map<std::string, CachedEntry<T>> &map, const std::string &key,
+                                 T value) {
+    lock_guard<mutex> guard(lock);
+    if (ttl_seconds == 0) {
+        return;
+    }
+    auto &entry = map[key];
+    entry.value = std::move(value);
+    entry.stored = std::chrono::steady_clock::now();
+}
+
+bool OdbcSchemaCache::Lookup(const std::string &key, OdbcSchema &schema) {
+    return LookupEntry(entries, key, schema);
+}
+
+void OdbcSchemaCache::Store(const std::string &key, OdbcSchema schema) {
+    StoreEntry(entries, key, std::move(schema));
+}
+
+idx_t OdbcSchemaCache::Clear() {
+    lock_guard<mutex> guard(lock);
+    auto count = entries.size();
+    entries.clear();
+    return count;
+}
+
+void OdbcSchemaCache::SetTTL(idx_t ttl_seconds_p) {
+    lock_guard<mutex> guard(lock);
+    ttl_seconds = ttl_seconds_p;
+    if (ttl_seconds == 0) {
+        entries.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+// odbc_clear_cache
+//------------------------------------------------------------------------------
+
+struct OdbcClearCacheState : public GlobalTableFunctionState {
+    bool finished = false;
+};
+
+static unique_ptr<FunctionData> BindClearCache(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+    return_types.emplace_back(LogicalTypeId::BOOLEAN);
+    names.emplace_back("Success");
+    return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> InitClearCache(ClientContext &context, TableFunctionInitInput &input) {
+    return make_uniq<OdbcClearCacheState>();
+}
+
+static void ClearCache(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &state = data.global_state->Cast<OdbcClearCacheState>();
+    if (state.finished) {
+        output.SetCardinality(0);
+        return;
+    }
+
+    OdbcSchemaCache::Get(context)->Clear();
+    OdbcResultCache::Get(context)->Clear();
+
+    output.SetCardinality(1);
+    output.SetValue(0, 0, Value::BOOLEAN(true));
+    state.finished = true;
+}
+
+TableFunction OdbcClearCacheFunction() {
+    return TableFunction("odbc_clear_cache", {}, ClearCache, BindClearCache, InitClearCache);
+}
+
+} // namespace duckdb
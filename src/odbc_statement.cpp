@@ -1,5 +1,7 @@
 #include "odbc_statement.hpp"
 #include "odbc_utils.hpp"
+#include "odbc_encoding.hpp"
+#include "odbc_rowset.hpp"
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/types/time.hpp"
@@ -7,10 +9,20 @@
 
 namespace duckdb {
 
-OdbcStatement::OdbcStatement(nanodbc::connection &conn, const std::string &query) : has_result(false), executed(false) {
+OdbcStatement::OdbcStatement(nanodbc::connection &conn, const std::string &query_p)
+    : query(query_p), has_result(false), executed(false) {
     try {
+        // Ask for a forward-only, read-only cursor before the statement is prepared. These are
+        // the ODBC defaults, but drivers configured for scrollable or updatable cursors would
+        // otherwise buffer the whole result (or hold locks) instead of streaming it. Drivers
+        // that cannot change them report an error that is ignored.
+        stmt = nanodbc::statement(conn);
+        auto handle = static_cast<SQLHSTMT>(stmt.native_statement_handle());
+        SQLSetStmtAttr(handle, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_FORWARD_ONLY, 0);
+        SQLSetStmtAttr(handle, SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_READ_ONLY, 0);
+        
         // Prepare the statement
-        stmt = nanodbc::statement(conn, query);
+        stmt.prepare(query);
     } catch (const nanodbc::database_error &e) {
         OdbcUtils::ThrowException("prepare statement", e);
     }
@@ -23,8 +35,12 @@ OdbcStatement::~OdbcStatement() {
 OdbcStatement::OdbcStatement(OdbcStatement &&other) noexcept
     : stmt(std::move(other.stmt))
     , result(std::move(other.result))
+    , query(std::move(other.query))
     , has_result(other.has_result)
-    , executed(other.executed) {
+    , executed(other.executed)
+    , rowset_size(other.rowset_size)
+    , query_timeout(other.query_timeout)
+    , parameters(std::move(other.parameters)) {
     // Reset the moved-from instance
     other.has_result = false;
     other.executed = false;
@@ -37,8 +53,12 @@ OdbcStatement &OdbcStatement::operator=(OdbcStatement &&other) noexcept {
         // Move in the new handles
         stmt = std::move(other.stmt);
         result = std::move(other.result);
+        query = std::move(other.query);
         has_result = other.has_result;
         executed = other.executed;
+        rowset_size = other.rowset_size;
+        query_timeout = other.query_timeout;
+        parameters = std::move(other.parameters);
         // Reset the moved-from object
         other.has_result = false;
         other.executed = false;
@@ -52,9 +72,16 @@ bool OdbcStatement::Step() {
     }
     
     try {
-        // On the first call, execute; on subsequent calls, advance the cursor
+        // On the first call, execute; on subsequent calls, advance the cursor.
+        // The statement runs for a single parameter set (parameters are bound as single
+        // values); the rowset size only sets SQL_ATTR_ROW_ARRAY_SIZE, so with a size > 1 the
+        // driver returns a block of rows per fetch and next() only goes back to the driver
+        // once the current block is consumed.
         if (!executed) {
-            result = stmt.execute();
+            nanodbc::batch_ops array_sizes;
+            array_sizes.parameter_array_length = 1;
+            array_sizes.rowset_size = static_cast<long>(rowset_size);
+            result = stmt.execute(array_sizes, static_cast<long>(query_timeout));
             executed = true;
             has_result = true;
         }
@@ -67,6 +94,47 @@ bool OdbcStatement::Step() {
     }
 }
 
+void OdbcStatement::Execute() {
+    if (!IsOpen()) {
+        throw BinderException("Statement is not open");
+    }
+    
+    try {
+        // Parameter set size stays 1 - rowset binding is up to the caller
+        stmt.just_execute(1, static_cast<long>(query_timeout));
+        executed = true;
+        has_result = false;
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("execute statement", e);
+    }
+}
+
+void OdbcStatement::ExecuteBatch(idx_t row_count) {
+    if (!IsOpen()) {
+        throw BinderException("Statement is not open");
+    }
+    
+    try {
+        // Sets SQL_ATTR_PARAMSET_SIZE so the driver sends all parameter sets at once
+        stmt.just_execute(static_cast<long>(row_count), static_cast<long>(query_timeout));
+        executed = true;
+        has_result = false;
+    } catch (const nanodbc::database_error &e) {
+        OdbcUtils::ThrowException("execute batch", e);
+    }
+}
+
+void OdbcStatement::SetRowsetSize(idx_t size) {
+    if (executed) {
+        throw InternalException("Cannot change the rowset size of an executed ODBC statement");
+    }
+    rowset_size = MaxValue<idx_t>(size, 1);
+}
+
+void OdbcStatement::SetQueryTimeout(idx_t seconds) {
+    query_timeout = seconds;
+}
+
 void OdbcStatement::Reset() {
     if (IsOpen()) {
         try {
@@ -79,6 +147,28 @@ void OdbcStatement::Reset() {
     }
 }
 
+bool OdbcStatement::Recycle() {
+    if (!IsOpen()) {
+        return false;
+    }
+    
+    // Release the nanodbc result first - it owns the buffers the columns are bound to
+    result = nanodbc::result();
+    has_result = false;
+    executed = false;
+    rowset_size = 1;
+    
+    auto handle = GetNativeHandle();
+    if (!SQL_SUCCEEDED(SQLFreeStmt(handle, SQL_CLOSE)) || !SQL_SUCCEEDED(SQLFreeStmt(handle, SQL_UNBIND))) {
+        return false;
+    }
+    SQLSetStmtAttr(handle, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+    SQLSetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+    stmt.reset_parameters();
+    parameters.clear();
+    return true;
+}
+
 void OdbcStatement::Close() {
     if (IsOpen()) {
         try {
@@ -102,6 +192,15 @@ SQLSMALLINT OdbcStatement::GetOdbcType(idx_t colIdx, SQLULEN* columnSize, SQLSMA
     
     try {
         if (!executed) {
+            std::string name;
+            SQLSMALLINT dataType;
+            SQLULEN size;
+            SQLSMALLINT digits;
+            if (DescribeColumn(colIdx, name, dataType, size, digits)) {
+                if (columnSize) *columnSize = size;
+                if (decimalDigits) *decimalDigits = digits;
+                return dataType;
+            }
             // Execute to get metadata
             result = stmt.execute();
             executed = true;
@@ -133,6 +232,13 @@ std::string OdbcStatement::GetName(idx_t colIdx) {
     
     try {
         if (!executed) {
+            std::string name;
+            SQLSMALLINT dataType;
+            SQLULEN size;
+            SQLSMALLINT digits;
+            if (DescribeColumn(colIdx, name, dataType, size, digits)) {
+                return name;
+            }
             // Execute to get metadata
             result = stmt.execute();
             executed = true;
@@ -153,10 +259,13 @@ idx_t OdbcStatement::GetColumnCount() {
     
     try {
         if (!executed) {
-            // Execute to get metadata
-            result = stmt.execute();
-            executed = true;
-            has_result = true;
+            // Prepared statements describe their result without running, so binding never
+            // executes anything. Statements without columns report 0 and are run by the scan.
+            SQLSMALLINT count = 0;
+            if (!SQL_SUCCEEDED(SQLNumResultCols(GetNativeHandle(), &count))) {
+                throw BinderException("Failed to describe the result of the prepared statement");
+            }
+            return static_cast<idx_t>(MaxValue<SQLSMALLINT>(count, 0));
         }
         
         return result.columns();
@@ -166,6 +275,43 @@ idx_t OdbcStatement::GetColumnCount() {
     }
 }
 
+bool OdbcStatement::DescribeColumn(idx_t colIdx, std::string &name, SQLSMALLINT &type, SQLULEN &size,
+                                   SQLSMALLINT &digits) {
+    // The name is read as wide characters, like every other name the extension gets from the
+    // driver, and asked for again if it did not fit (lengths are in characters)
+    std::vector<SQLWCHAR> name_buffer(256);
+    SQLSMALLINT name_length = 0;
+    SQLSMALLINT nullable = 0;
+    auto column = static_cast<SQLUSMALLINT>(colIdx + 1);
+    auto ret = SQLDescribeColW(GetNativeHandle(), column, name_buffer.data(),
+                               static_cast<SQLSMALLINT>(name_buffer.size()), &name_length, &type, &size, &digits,
+                               &nullable);
+    if (SQL_SUCCEEDED(ret) && name_length >= static_cast<SQLSMALLINT>(name_buffer.size())) {
+        name_buffer.resize(static_cast<idx_t>(name_length) + 1);
+        ret = SQLDescribeColW(GetNativeHandle(), column, name_buffer.data(),
+                              static_cast<SQLSMALLINT>(name_buffer.size()), &name_length, &type, &size, &digits,
+                              &nullable);
+    }
+    if (!SQL_SUCCEEDED(ret)) {
+        return false;
+    }
+    name_length = MinValue<SQLSMALLINT>(MaxValue<SQLSMALLINT>(name_length, 0),
+                                        static_cast<SQLSMALLINT>(name_buffer.size() - 1));
+    name = OdbcEncoding::WideToString(reinterpret_cast<const odbc_wide_unit_t *>(name_buffer.data()),
+                                      static_cast<idx_t>(name_length));
+    
+    // Same metadata as the executed path (see OdbcUtils::GetColumnMetadata)
+    bool sized = type == SQL_NUMERIC || type == SQL_DECIMAL || type == SQL_CHAR || type == SQL_VARCHAR ||
+                 type == SQL_WCHAR || type == SQL_WVARCHAR || type == SQL_BINARY || type == SQL_VARBINARY;
+    if (!sized) {
+        size = 0;
+        digits = 0;
+    } else if (type != SQL_NUMERIC && type != SQL_DECIMAL) {
+        digits = 0;
+    }
+    return true;
+}
+
 bool OdbcStatement::IsNull(idx_t colIdx) const {
     if (!has_result) {
         throw BinderException("No result available");
@@ -174,6 +320,14 @@ bool OdbcStatement::IsNull(idx_t colIdx) const {
     return result.is_null(colIdx);
 }
 
+bool OdbcStatement::IsBound(idx_t colIdx) const {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    return result.is_bound(static_cast<short>(colIdx));
+}
+
 std::string OdbcStatement::GetString(idx_t colIdx) {
     if (!has_result) {
         throw BinderException("No result available");
@@ -192,6 +346,87 @@ std::string OdbcStatement::GetString(idx_t colIdx) {
     }
 }
 
+void OdbcStatement::GetString(idx_t colIdx, std::string &out) {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    try {
+        if (result.is_null(colIdx)) {
+            out.clear();
+            return;
+        }
+        
+        result.get_ref<std::string>(static_cast<short>(colIdx), out);
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("get string value", e);
+    }
+}
+
+const char *OdbcStatement::GetBoundData(idx_t colIdx, SQLSMALLINT &c_type, SQLLEN &length,
+                                        SQLLEN &capacity) const {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    short type = 0;
+    long long indicator = 0;
+    long long buffer_size = 0;
+    auto data = result.bound_data(static_cast<short>(colIdx), type, indicator, buffer_size);
+    c_type = type;
+    length = static_cast<SQLLEN>(indicator);
+    capacity = static_cast<SQLLEN>(buffer_size);
+    return data;
+}
+
+void OdbcStatement::GetDataString(idx_t colIdx, SQLSMALLINT c_type, std::string &out) {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    try {
+        result.select_current_row();
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("position cursor", e);
+    }
+    
+    // Read in chunks; every chunk is null-terminated, so all but the last lose their final unit
+    idx_t unit = c_type == SQL_C_WCHAR ? sizeof(SQLWCHAR) : 1;
+    std::vector<char> buffer(4096);
+    std::string data;
+    while (true) {
+        SQLLEN indicator = 0;
+        auto ret = SQLGetData(GetNativeHandle(), static_cast<SQLUSMALLINT>(colIdx + 1), c_type, buffer.data(),
+                              static_cast<SQLLEN>(buffer.size()), &indicator);
+        if (ret == SQL_NO_DATA) {
+            break;
+        }
+        if (!SQL_SUCCEEDED(ret)) {
+            throw InvalidInputException("Failed to read column %llu: the value does not fit into the bound buffer "
+                                        "and the driver cannot read bound columns with SQLGetData",
+                                        static_cast<unsigned long long>(colIdx + 1));
+        }
+        if (indicator == SQL_NULL_DATA) {
+            break;
+        }
+        idx_t chunk = buffer.size() - unit;
+        if (indicator != SQL_NO_TOTAL && static_cast<idx_t>(indicator) < chunk) {
+            chunk = static_cast<idx_t>(indicator);
+        }
+        data.append(buffer.data(), chunk);
+        if (ret == SQL_SUCCESS) {
+            break;
+        }
+    }
+    
+    if (c_type == SQL_C_WCHAR) {
+        out = OdbcEncoding::WideToString(reinterpret_cast<const odbc_wide_unit_t *>(data.data()),
+                                         data.size() / sizeof(SQLWCHAR));
+    } else {
+        out = std::move(data);
+    }
+}
+
 int32_t OdbcStatement::GetInt32(idx_t colIdx) {
     if (!has_result) {
         throw BinderException("No result available");
@@ -243,6 +478,42 @@ double OdbcStatement::GetDouble(idx_t colIdx) {
     }
 }
 
+date_t OdbcStatement::GetDate(idx_t colIdx) {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    try {
+        if (result.is_null(colIdx)) {
+            return date_t::epoch();
+        }
+        
+        nanodbc::date d = result.get<nanodbc::date>(colIdx);
+        return Date::FromDate(d.year, d.month, d.day);
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("get date value", e);
+        return date_t::epoch(); // Won't reach here due to exception
+    }
+}
+
+dtime_t OdbcStatement::GetTime(idx_t colIdx) {
+    if (!has_result) {
+        throw BinderException("No result available");
+    }
+    
+    try {
+        if (result.is_null(colIdx)) {
+            return dtime_t(0);
+        }
+        
+        nanodbc::time t = result.get<nanodbc::time>(colIdx);
+        return Time::FromTime(t.hour, t.min, t.sec, 0);
+    } catch (const nanodbc::database_error& e) {
+        OdbcUtils::ThrowException("get time value", e);
+        return dtime_t(0); // Won't reach here due to exception
+    }
+}
+
 timestamp_t OdbcStatement::GetTimestamp(idx_t colIdx) {
     if (!has_result) {
         throw BinderException("No result available");
@@ -257,9 +528,9 @@ timestamp_t OdbcStatement::GetTimestamp(idx_t colIdx) {
         // Get timestamp using nanodbc
         nanodbc::timestamp ts = result.get<nanodbc::timestamp>(colIdx);
         
-        // Convert to DuckDB timestamp
+        // Convert to DuckDB timestamp (fract is in nanoseconds)
         date_t date = Date::FromDate(ts.year, ts.month, ts.day);
-        dtime_t time = Time::FromTime(ts.hour, ts.min, ts.sec, ts.fract / 1000000);
+        dtime_t time = Time::FromTime(ts.hour, ts.min, ts.sec, ts.fract / 1000);
         return Timestamp::FromDatetime(date, time);
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("get timestamp value", e);
@@ -285,7 +556,9 @@ void OdbcStatement::BindInt32(idx_t colIdx, int32_t value) {
     }
     
     try {
-        stmt.bind(colIdx, &value);
+        auto &param = parameters[colIdx];
+        param.int32_value = value;
+        stmt.bind(colIdx, &param.int32_value);
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("bind int32 parameter", e);
     }
@@ -297,7 +570,9 @@ void OdbcStatement::BindInt64(idx_t colIdx, int64_t value) {
     }
     
     try {
-        stmt.bind(colIdx, &value);
+        auto &param = parameters[colIdx];
+        param.int64_value = value;
+        stmt.bind(colIdx, &param.int64_value);
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("bind int64 parameter", e);
     }
@@ -309,7 +584,9 @@ void OdbcStatement::BindDouble(idx_t colIdx, double value) {
     }
     
     try {
-        stmt.bind(colIdx, &value);
+        auto &param = parameters[colIdx];
+        param.double_value = value;
+        stmt.bind(colIdx, &param.double_value);
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("bind double parameter", e);
     }
@@ -321,7 +598,9 @@ void OdbcStatement::BindString(idx_t colIdx, const std::string& value) {
     }
     
     try {
-        stmt.bind(colIdx, value.c_str());
+        auto &param = parameters[colIdx];
+        param.string_value = value;
+        stmt.bind(colIdx, param.string_value.c_str());
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("bind string parameter", e);
     }
@@ -333,7 +612,10 @@ void OdbcStatement::BindBlob(idx_t colIdx, const char* data, size_t size) {
     }
     
     try {
-        stmt.bind(colIdx, data, size);
+        // The binary overload copies the value into the statement
+        std::vector<std::vector<uint8_t>> values(1);
+        values[0].assign(data, data + size);
+        stmt.bind(colIdx, values);
     } catch (const nanodbc::database_error& e) {
         OdbcUtils::ThrowException("bind blob parameter", e);
     }
@@ -383,4 +665,41 @@ void OdbcStatement::BindValue(Vector &col, idx_t colIdx, idx_t rowIdx) {
     }
 }
 
+void OdbcStatement::BindParameter(idx_t colIdx, const Value &value) {
+    if (value.IsNull()) {
+        BindNull(colIdx);
+        return;
+    }
+    
+    switch (value.type().id()) {
+        case LogicalTypeId::BOOLEAN:
+            BindInt32(colIdx, BooleanValue::Get(value) ? 1 : 0);
+            break;
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+            BindInt32(colIdx, value.GetValue<int32_t>());
+            break;
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::UINTEGER:
+            BindInt64(colIdx, value.GetValue<int64_t>());
+            break;
+        case LogicalTypeId::FLOAT:
+        case LogicalTypeId::DOUBLE:
+            BindDouble(colIdx, value.GetValue<double>());
+            break;
+        case LogicalTypeId::BLOB: {
+            auto &blob = StringValue::Get(value);
+            BindBlob(colIdx, blob.data(), blob.size());
+            break;
+        }
+        default:
+            // DECIMAL, UBIGINT, HUGEINT, dates, times, UUID, ... in their text form
+            BindString(colIdx, value.ToString());
+            break;
+    }
+}
+
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "odbc_statistics.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_scanner.hpp"
+#include "odbc_statement.hpp"
+#include "odbc_utils.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+
+namespace duckdb {
+
+void OdbcStatistics::RegisterSettings(DBConfig &config) {
+    config.AddExtensionOption("odbc_count_rows",
+                              "Run COUNT(*) at bind time for ODBC tables whose data source reports no row count",
+                              LogicalType::BOOLEAN, Value::BOOLEAN(false));
+    config.AddExtensionOption("odbc_column_statistics",
+                              "Read MIN/MAX of scanned ODBC columns for the optimizer (once per query)",
+                              LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+static bool GetBooleanSetting(ClientContext &context, const char *name) {
+    Value value;
+    if (context.TryGetCurrentSetting(name, value) && !value.IsNull()) {
+        return BooleanValue::Get(value);
+    }
+    return false;
+}
+
+static std::string QualifiedName(const std::string &schema_name, const std::string &table_name) {
+    auto table = "\"" + OdbcUtils::SanitizeString(table_name) + "\"";
+    if (schema_name.empty()) {
+        return table;
+    }
+    return "\"" + OdbcUtils::SanitizeString(schema_name) + "\"." + table;
+}
+
+// Single numeric value returned by a statistics query
+static optional_idx QueryRowCount(OdbcConnection &db, const std::string &query) {
+    auto stmt = db.Prepare(query);
+    if (!stmt->Step() || stmt->IsNull(0)) {
+        return optional_idx();
+    }
+    // Read as double - PostgreSQL's reltuples is a real
+    auto rows = stmt->GetDouble(0);
+    if (rows < 0) {
+        return optional_idx();
+    }
+    return optional_idx(static_cast<idx_t>(rows));
+}
+
+optional_idx OdbcStatistics::EstimateRowCount(ClientContext &context, OdbcConnection &db, const std::string &dbms_name,
+                                              const std::string &schema_name, const std::string &table_name) {
+    try {
+        auto cardinality = db.GetTableCardinality(schema_name, table_name);
+        if (cardinality.IsValid()) {
+            return cardinality;
+        }
+
+        auto query = OdbcDialect::RowCountQuery(dbms_name, schema_name, table_name);
+        if (!query.empty()) {
+            try {
+                cardinality = QueryRowCount(db, query);
+            } catch (const std::exception &) {
+                // No access to the statistics view - try the next source
+            }
+            if (cardinality.IsValid()) {
+                return cardinality;
+            }
+        }
+
+        if (GetBooleanSetting(context, "odbc_count_rows")) {
+            return QueryRowCount(db, "SELECT COUNT(*) FROM " + QualifiedName(schema_name, table_name));
+        }
+    } catch (const std::exception &) {
+        // Unknown row count
+    }
+    return optional_idx();
+}
+
+// Types whose min/max DuckDB can use and whose text form casts back reliably
+static bool SupportsRange(const LogicalType &type) {
+    switch (type.id()) {
+        case LogicalTypeId::TINYINT:
+        case LogicalTypeId::SMALLINT:
+        case LogicalTypeId::INTEGER:
+        case LogicalTypeId::BIGINT:
+        case LogicalTypeId::UTINYINT:
+        case LogicalTypeId::USMALLINT:
+        case LogicalTypeId::UINTEGER:
+        case LogicalTypeId::UBIGINT:
+        case LogicalTypeId::DECIMAL:
+        case LogicalTypeId::DATE:
+        case LogicalTypeId::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+unique_ptr<BaseStatistics> OdbcStatistics::GetColumnStatistics(ClientContext &context,
+                                                               const OdbcScannerState &bind_data,
+                                                               column_t column_id) {
+    if (bind_data.table_name.empty() || column_id >= bind_data.column_types.size() ||
+        !GetBooleanSetting(context, "odbc_column_statistics")) {
+        return nullptr;
+    }
+    auto &type = bind_data.column_types[column_id];
+    if (!SupportsRange(type)) {
+        return nullptr;
+    }
+    auto &column = bind_data.column_names[column_id];
+
+    // DuckDB prunes filters with these bounds, so they are read for every query instead of
+    // being cached: rows written since an earlier query must not be filtered out
+    auto table = QualifiedName(bind_data.schema_name, bind_data.table_name);
+    Value min, max;
+    try {
+        auto db = OdbcConnectionPool::Acquire(context, bind_data.connection_params);
+        auto quoted_column = "\"" + OdbcUtils::SanitizeString(column) + "\"";
+        auto stmt = db->Prepare("SELECT MIN(" + quoted_column + "), MAX(" + quoted_column + ") FROM " + table);
+        if (!stmt->Step() || stmt->IsNull(0) || stmt->IsNull(1)) {
+            return nullptr;
+        }
+        // Drivers format numbers and dates the way DuckDB parses them; anything else gives no range
+        if (!Value(stmt->GetString(0)).DefaultTryCastAs(type, min) ||
+            !Value(stmt->GetString(1)).DefaultTryCastAs(type, max)) {
+            return nullptr;
+        }
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+
+    auto result = BaseStatistics::CreateUnknown(type);
+    NumericStats::SetMin(result, min);
+    NumericStats::SetMax(result, max);
+    return result.ToUnique();
+}
+
+} // namespace duckdb
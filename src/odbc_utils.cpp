@@ -1,6 +1,8 @@
 #include "odbc_utils.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/operator/decimal_cast_operators.hpp"
+#include "duckdb/common/types/decimal.hpp"
 
 namespace duckdb {
 
@@ -31,6 +33,8 @@ const std::unordered_map<SQLSMALLINT, LogicalTypeId> OdbcUtils::ODBC_TO_DUCKDB_T
     {SQL_TYPE_TIME, LogicalTypeId::TIME},
     {SQL_TIMESTAMP, LogicalTypeId::TIMESTAMP},
     {SQL_TYPE_TIMESTAMP, LogicalTypeId::TIMESTAMP},
+    {SQL_SS_TIME2, LogicalTypeId::TIME},
+    {SQL_SS_TIMESTAMPOFFSET, LogicalTypeId::TIMESTAMP_TZ},
     {SQL_GUID, LogicalTypeId::UUID}
 };
 
@@ -81,6 +85,8 @@ const std::unordered_map<SQLSMALLINT, std::string> OdbcUtils::TYPE_NAMES = {
     {SQL_TYPE_DATE, "DATE"},
     {SQL_TYPE_TIME, "TIME"},
     {SQL_TYPE_TIMESTAMP, "TIMESTAMP"},
+    {SQL_SS_TIME2, "TIME"},
+    {SQL_SS_TIMESTAMPOFFSET, "DATETIMEOFFSET"},
     {SQL_GUID, "GUID"}
 };
 
@@ -109,6 +115,12 @@ LogicalType OdbcUtils::OdbcTypeToLogicalType(SQLSMALLINT odbcType, SQLULEN colum
         if (typeId == LogicalTypeId::DECIMAL) {
             if (columnSize == 0) columnSize = 38;  // Default precision
             // if (decimalDigits == 0 && odbcType == SQL_DECIMAL) decimalDigits = 2;  // Default scale
+            if (columnSize > Decimal::MAX_WIDTH_DECIMAL) {
+                // Unconstrained NUMERIC (e.g. PostgreSQL) does not fit any DuckDB decimal
+                return LogicalType::DOUBLE;
+            }
+            if (decimalDigits < 0) decimalDigits = 0;
+            if ((SQLULEN)decimalDigits > columnSize) decimalDigits = (SQLSMALLINT)columnSize;
             return LogicalType::DECIMAL(columnSize, decimalDigits);
         }
         
@@ -119,6 +131,35 @@ LogicalType OdbcUtils::OdbcTypeToLogicalType(SQLSMALLINT odbcType, SQLULEN colum
     return LogicalType::VARCHAR;
 }
 
+bool OdbcUtils::ParseDecimal(const std::string& text, Vector& out, idx_t row) {
+    return ParseDecimal(text.data(), text.size(), out, row);
+}
+
+bool OdbcUtils::ParseDecimal(const char* data, idx_t length, Vector& out, idx_t row) {
+    auto& type = out.GetType();
+    auto width = DecimalType::GetWidth(type);
+    auto scale = DecimalType::GetScale(type);
+    string_t value(data, static_cast<uint32_t>(length));
+    CastParameters parameters;
+    
+    switch (type.InternalType()) {
+        case PhysicalType::INT16:
+            return TryCastToDecimal::Operation<string_t, int16_t>(value, FlatVector::GetData<int16_t>(out)[row], 
+                                                                  parameters, width, scale);
+        case PhysicalType::INT32:
+            return TryCastToDecimal::Operation<string_t, int32_t>(value, FlatVector::GetData<int32_t>(out)[row], 
+                                                                  parameters, width, scale);
+        case PhysicalType::INT64:
+            return TryCastToDecimal::Operation<string_t, int64_t>(value, FlatVector::GetData<int64_t>(out)[row], 
+                                                                  parameters, width, scale);
+        case PhysicalType::INT128:
+            return TryCastToDecimal::Operation<string_t, hugeint_t>(value, FlatVector::GetData<hugeint_t>(out)[row],
+                                                                    parameters, width, scale);
+        default:
+            return false;
+    }
+}
+
 SQLSMALLINT OdbcUtils::LogicalTypeToOdbcType(const LogicalType& type) {
     auto it = DUCKDB_TO_ODBC_TYPES.find(type.id());
     if (it != DUCKDB_TO_ODBC_TYPES.end()) {